@@ -42,6 +42,12 @@ struct Identifier<Type> {
         return index;
     }
 
+    template<typename Other>
+    constexpr std::size_t get() const {
+        static_assert(std::is_same<std::decay_t<Other>, Type>::value, "!");
+        return index;
+    }
+
 private:
     const std::size_t index;
 };
@@ -76,7 +82,8 @@ private:
  * @endcode
  *
  * @note
- * In case of single type list, `get` isn't a member function template:
+ * In case of single type list, `get` is also available as a non-template
+ * member function:
  * @code{.cpp}
  * func(std::integral_constant<
  *     entt::ident<AType>::identifier_type,
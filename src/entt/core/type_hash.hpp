@@ -0,0 +1,188 @@
+#ifndef ENTT_CORE_TYPE_HASH_HPP
+#define ENTT_CORE_TYPE_HASH_HPP
+
+
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <vector>
+#include "hashed_string.hpp"
+
+
+#if defined _MSC_VER
+#define ENTT_PRETTY_FUNCTION __FUNCSIG__
+#else
+#define ENTT_PRETTY_FUNCTION __PRETTY_FUNCTION__
+#endif
+
+
+namespace entt {
+
+
+/**
+ * @brief Compile-time type identifier.
+ *
+ * The identifier of a type is the hash of the name of the type as it's
+ * reported by the compiler. Unlike the ones returned by Family, these
+ * identifiers don't depend on the order in which types are used. They are
+ * stable between runs, as well as between executables and shared libraries
+ * built with the same compiler. Therefore they can be freely stored aside or
+ * shared.
+ *
+ * Identifiers are constant expressions and accessing them at runtime doesn't
+ * require any kind of initialization or guard:
+ * @code{.cpp}
+ * constexpr auto identifier = entt::TypeHash<AType>::value();
+ * @endcode
+ *
+ * @note
+ * Identifiers are hashes and as such they aren't dense. Use a HashIndex to map
+ * them to dense indexes if required.
+ *
+ * @tparam Type Type for which to generate an identifier.
+ */
+template<typename Type>
+struct TypeHash final {
+    /*! @brief Unsigned integer type. */
+    using hash_type = HashedString::hash_type;
+
+private:
+    static constexpr hash_type helper() noexcept {
+        // Fowler–Noll–Vo hash function v. 1a, the same used by HashedString
+        const char *str = ENTT_PRETTY_FUNCTION;
+        hash_type partial = 14695981039346656037u;
+
+        while(*str) {
+            partial = (partial ^ *(str++)) * 1099511628211u;
+        }
+
+        return partial;
+    }
+
+public:
+    /**
+     * @brief Returns the identifier of the given type.
+     * @return Statically generated identifier for the given type.
+     */
+    static constexpr hash_type value() noexcept {
+        // forces the evaluation at compile-time, whatever the context
+        return std::integral_constant<hash_type, helper()>::value;
+    }
+};
+
+
+/**
+ * @brief Maps type identifiers to dense indexes.
+ *
+ * Open addressing hash table that assigns consecutive indexes to type
+ * identifiers in the order they are inserted. It's meant to be used by
+ * containers that arrange their elements by type in contiguous memory.<br/>
+ * Both insertions and lookups are constant time operations on average and
+ * don't depend on static variables of any type.
+ *
+ * @note
+ * Dense indexes depend on the order in which types are inserted and are local
+ * to an instance. Use the type identifiers whenever a stable value is
+ * required.
+ */
+class HashIndex final {
+    using hash_type = HashedString::hash_type;
+    using element_type = std::pair<hash_type, std::size_t>;
+
+    void rehash(std::size_t sz) {
+        std::vector<element_type> other(sz, element_type{hash_type{}, size_type{null}});
+        table.swap(other);
+
+        for(auto &&element: other) {
+            if(element.second != null) {
+                table[slot(element.first)] = element;
+            }
+        }
+    }
+
+    std::size_t slot(hash_type hash) const noexcept {
+        const auto mask = table.size() - 1;
+        auto pos = std::size_t(hash) & mask;
+
+        while(table[pos].second != null && table[pos].first != hash) {
+            pos = (pos + 1) & mask;
+        }
+
+        return pos;
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /*! @brief Value returned when an identifier isn't part of the index. */
+    static constexpr size_type null = ~size_type{};
+
+    /**
+     * @brief Returns the number of identifiers in the index.
+     * @return Number of identifiers in the index.
+     */
+    size_type size() const noexcept {
+        return count;
+    }
+
+    /**
+     * @brief Checks whether the index is empty.
+     * @return True if the index is empty, false otherwise.
+     */
+    bool empty() const noexcept {
+        return !count;
+    }
+
+    /**
+     * @brief Returns the dense index of a type identifier.
+     * @param hash A type identifier.
+     * @return The dense index of the identifier if it's part of the index,
+     * `null` otherwise.
+     */
+    size_type find(hash_type hash) const noexcept {
+        return table.empty() ? size_type{null} : table[slot(hash)].second;
+    }
+
+    /**
+     * @brief Returns the dense index of a type identifier and assigns a new one
+     * if required.
+     *
+     * The index is modified only when a new identifier is inserted. Inserting
+     * an identifier that is already part of the index is a read-only operation.
+     *
+     * @param hash A type identifier.
+     * @return The dense index of the identifier.
+     */
+    size_type insert(hash_type hash) {
+        auto pos = find(hash);
+
+        // the table grows only on actual insertions, lookups never modify it
+        if(pos == null) {
+            if(!(2 * (count + 1) <= table.size())) {
+                rehash(table.empty() ? size_type{16} : 2 * table.size());
+            }
+
+            pos = count++;
+            table[slot(hash)] = element_type{hash, pos};
+        }
+
+        return pos;
+    }
+
+    /*! @brief Clears the index. */
+    void clear() noexcept {
+        table.clear();
+        count = 0;
+    }
+
+private:
+    std::vector<element_type> table{};
+    size_type count{};
+};
+
+
+}
+
+
+#endif // ENTT_CORE_TYPE_HASH_HPP
@@ -0,0 +1,231 @@
+#ifndef ENTT_ENTITY_ENTITY_STORAGE_HPP
+#define ENTT_ENTITY_ENTITY_STORAGE_HPP
+
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include "traits.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Storage for entity identifiers shared by the registries.
+ *
+ * Entities are stored in a single array, one slot for each entity ever
+ * created. Slots of destroyed entities form an implicit list of free positions:
+ * each of them stores the position of the next free slot along with the version
+ * to use when the identifier is recycled. Therefore, no extra memory is
+ * required to keep track of the identifiers available for reuse.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ */
+template<typename Entity>
+class EntityStorage final {
+    using traits_type = entt_traits<Entity>;
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = typename traits_type::entity_type;
+    /*! @brief Underlying version type. */
+    using version_type = typename traits_type::version_type;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Returns the number of entities still in use.
+     * @return Number of entities still in use.
+     */
+    size_type size() const noexcept {
+        return entities.size() - free;
+    }
+
+    /**
+     * @brief Returns the number of entities ever created.
+     * @return Number of entities ever created.
+     */
+    size_type capacity() const noexcept {
+        return entities.size();
+    }
+
+    /**
+     * @brief Returns the number of identifiers available for reuse.
+     * @return Number of entities in the list of free identifiers.
+     */
+    size_type available() const noexcept {
+        return free;
+    }
+
+    /**
+     * @brief Checks if there exists at least an entity still in use.
+     * @return True if at least an entity is still in use, false otherwise.
+     */
+    bool empty() const noexcept {
+        return entities.size() == free;
+    }
+
+    /**
+     * @brief Returns the footprint of the storage.
+     * @return The number of bytes allocated for the entities.
+     */
+    size_type bytes() const noexcept {
+        return entities.capacity() * sizeof(entity_type);
+    }
+
+    /**
+     * @brief Verifies if an entity identifier still refers to a valid entity.
+     * @param entity An entity identifier, either valid or not.
+     * @return True if the identifier is still valid, false otherwise.
+     */
+    bool valid(entity_type entity) const noexcept {
+        const auto entt = entity & traits_type::entity_mask;
+        return (entt < entities.size() && entities[entt] == entity);
+    }
+
+    /**
+     * @brief Returns the version stored along with an entity identifier.
+     * @param entity An entity identifier, either valid or not.
+     * @return Version stored along with the given entity identifier.
+     */
+    static version_type version(entity_type entity) noexcept {
+        return version_type((entity >> traits_type::entity_shift) & traits_type::version_mask);
+    }
+
+    /**
+     * @brief Returns the actual version for an entity identifier.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the storage results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't own the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @return Actual version for the given entity identifier.
+     */
+    version_type current(entity_type entity) const noexcept {
+        const auto entt = entity & traits_type::entity_mask;
+        assert(entt < entities.size());
+        return version(entities[entt]);
+    }
+
+    /**
+     * @brief Creates a new entity, recycling an identifier if possible.
+     * @return A valid entity identifier.
+     */
+    entity_type create() noexcept {
+        entity_type entity;
+
+        if(free) {
+            // the slot stores the next free position along with the new version
+            const auto entt = next;
+            const auto version = entities[entt] & (~traits_type::entity_mask);
+            next = entities[entt] & traits_type::entity_mask;
+            entity = entt | version;
+            entities[entt] = entity;
+            --free;
+        } else {
+            entity = entity_type(entities.size());
+            assert(entity < traits_type::entity_mask);
+            assert((entity >> traits_type::entity_shift) == entity_type{});
+            entities.push_back(entity);
+        }
+
+        return entity;
+    }
+
+    /**
+     * @brief Releases an entity and makes its identifier available for reuse.
+     *
+     * @warning
+     * Attempting to use an invalid entity results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity.
+     *
+     * @param entity A valid entity identifier.
+     */
+    void release(entity_type entity) noexcept {
+        assert(valid(entity));
+        const auto entt = entity & traits_type::entity_mask;
+        const auto version = (((entity >> traits_type::entity_shift) + 1) & traits_type::version_mask) << traits_type::entity_shift;
+        // the slot becomes the head of the implicit list of free positions
+        entities[entt] = next | version;
+        next = entt;
+        ++free;
+    }
+
+    /**
+     * @brief Releases all the entities.
+     *
+     * Entities still in use get a new version, all the identifiers become
+     * available for reuse.
+     */
+    void reset() noexcept {
+        next = entity_type(traits_type::entity_mask);
+
+        for(size_type pos = 0, last = entities.size(); pos < last; ++pos) {
+            const auto entt = entity_type(pos);
+            auto version = entities[entt] & (~traits_type::entity_mask);
+
+            if((entities[entt] & traits_type::entity_mask) == entt) {
+                // entities still in use get a new version, the others already have it
+                version = (((version >> traits_type::entity_shift) + 1) & traits_type::version_mask) << traits_type::entity_shift;
+            }
+
+            entities[entt] = next | version;
+            next = entt;
+        }
+
+        free = entities.size();
+    }
+
+    /**
+     * @brief Iterates all the entities that are still in use.
+     *
+     * The function object is invoked for each entity that is still in use.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(entity_type);
+     * @endcode
+     *
+     * @note
+     * Releasing the entity currently pointed during an iteration is allowed.
+     * Entities created during an iteration may or may not be returned.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) const {
+        if(free) {
+            for(auto pos = entities.size(); pos; --pos) {
+                const auto entt = entity_type(pos - 1);
+                const auto entity = entities[entt];
+
+                // free positions always refer to a different slot (or none)
+                if((entity & traits_type::entity_mask) == entt) {
+                    func(entity);
+                }
+            }
+        } else {
+            for(auto pos = entities.size(); pos; --pos) {
+                func(entities[pos-1]);
+            }
+        }
+    }
+
+private:
+    std::vector<entity_type> entities{};
+    size_type free{};
+    // the entity mask is never a valid position and terminates the free list
+    entity_type next{entity_type(traits_type::entity_mask)};
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_ENTITY_STORAGE_HPP
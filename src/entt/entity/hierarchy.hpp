@@ -0,0 +1,367 @@
+#ifndef ENTT_ENTITY_HIERARCHY_HPP
+#define ENTT_ENTITY_HIERARCHY_HPP
+
+
+#include <utility>
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include "sparse_set.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Parent-child relationships between entities.
+ *
+ * A hierarchy is a sparse set that keeps its packed array sorted so that
+ * parents always precede their children. The order is kept valid when entities
+ * are assigned, destroyed or reparented and it's updated incrementally, only
+ * the elements that follow the affected entities are moved around.<br/>
+ * As a consequence, propagating data from parents to children (as an example,
+ * transforms) is a single linear pass over the packed array and doesn't require
+ * any kind of recursion:
+ *
+ * @code{.cpp}
+ * hierarchy.each([&registry](auto entity, auto parent) {
+ *     auto &transform = registry.get<Transform>(entity);
+ *     transform.world = (entity == parent) ? transform.local : registry.get<Transform>(parent).world * transform.local;
+ * });
+ * @endcode
+ *
+ * Roots are their own parents.
+ *
+ * @note
+ * Input iterators return the entities in the reverse order, that is children
+ * always precede their parents. Other sets can be sorted the same way by means
+ * of their `respect` member function.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ */
+template<typename Entity>
+class Hierarchy final: public SparseSet<Entity> {
+    using underlying_type = SparseSet<Entity>;
+
+    struct Node final {
+        Entity parent;
+        std::size_t children;
+    };
+
+    void swap(Entity lhs, Entity rhs) override {
+        std::swap(nodes[underlying_type::get(lhs)], nodes[underlying_type::get(rhs)]);
+        underlying_type::swap(lhs, rhs);
+    }
+
+    void arrange(const std::vector<Entity> &order) override {
+        const auto *direct = underlying_type::data();
+
+        for(size_type pos = 0, last = order.size(); pos < last; ++pos) {
+            if(direct[pos] != order[pos]) {
+                Hierarchy::swap(direct[pos], order[pos]);
+            }
+        }
+    }
+
+    void detach(Entity entity) {
+        const auto parent = nodes[underlying_type::get(entity)].parent;
+
+        if(parent != entity) {
+            --nodes[underlying_type::get(parent)].children;
+        }
+    }
+
+    bool descendant(Entity entity, Entity ancestor) const noexcept {
+        auto curr = entity;
+        auto next = parent(curr);
+
+        while(curr != ancestor && next != curr) {
+            curr = next;
+            next = parent(curr);
+        }
+
+        return curr == ancestor;
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = typename underlying_type::entity_type;
+    /*! @brief Entity dependent position type. */
+    using pos_type = typename underlying_type::pos_type;
+    /*! @brief Unsigned integer type. */
+    using size_type = typename underlying_type::size_type;
+    /*! @brief Input iterator type. */
+    using iterator_type = typename underlying_type::iterator_type;
+
+    /*! @brief Default constructor. */
+    Hierarchy() noexcept = default;
+
+    /*! @brief Copying a hierarchy isn't allowed. */
+    Hierarchy(const Hierarchy &) = delete;
+    /*! @brief Default move constructor. */
+    Hierarchy(Hierarchy &&) = default;
+
+    /*! @brief Copying a hierarchy isn't allowed. @return This hierarchy. */
+    Hierarchy & operator=(const Hierarchy &) = delete;
+    /*! @brief Default move assignment operator. @return This hierarchy. */
+    Hierarchy & operator=(Hierarchy &&) = default;
+
+    /*! @brief Sorting a hierarchy isn't allowed. */
+    template<typename Compare>
+    void sort(Compare) = delete;
+
+    /*! @brief Sorting a hierarchy isn't allowed. */
+    void respect(const SparseSet<Entity> &) = delete;
+
+    using underlying_type::policy;
+
+    /*! @brief Tombstones would break the order, they aren't allowed. */
+    void policy(DeletionPolicy) = delete;
+
+    /**
+     * @brief Returns the parent of an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the hierarchy results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * hierarchy doesn't contain the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @return The parent of the entity, the entity itself for roots.
+     */
+    entity_type parent(entity_type entity) const noexcept {
+        return nodes[underlying_type::get(entity)].parent;
+    }
+
+    /**
+     * @brief Returns the number of children of an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the hierarchy results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * hierarchy doesn't contain the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @return The number of direct children of the entity.
+     */
+    size_type children(entity_type entity) const noexcept {
+        return nodes[underlying_type::get(entity)].children;
+    }
+
+    /**
+     * @brief Assigns an entity to a hierarchy as a root.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the hierarchy
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * hierarchy already contains the given entity.
+     *
+     * @param entity A valid entity identifier.
+     */
+    void construct(entity_type entity) {
+        underlying_type::construct(entity);
+        nodes.push_back(Node{entity, 0});
+    }
+
+    /**
+     * @brief Assigns an entity to a hierarchy as a child of another entity.
+     *
+     * New entities are appended to the packed array, therefore this is a
+     * constant time operation.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the hierarchy or
+     * to use a parent that doesn't belong to the hierarchy results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entities.
+     *
+     * @param entity A valid entity identifier.
+     * @param parent A valid entity identifier.
+     */
+    void construct(entity_type entity, entity_type parent) {
+        ++nodes[underlying_type::get(parent)].children;
+        underlying_type::construct(entity);
+        nodes.push_back(Node{parent, 0});
+    }
+
+    /**
+     * @brief Changes the parent of an entity.
+     *
+     * Use the entity itself as a parent to turn it into a root.<br/>
+     * If the new parent already precedes the entity, this is a constant time
+     * operation. Otherwise the entity and its descendants are moved after the
+     * new parent and the cost is linear in the number of elements that follow
+     * the entity.
+     *
+     * @warning
+     * Attempting to use entities that don't belong to the hierarchy or to
+     * attach an entity to one of its descendants results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entities or cycles.
+     *
+     * @param entity A valid entity identifier.
+     * @param parent A valid entity identifier.
+     */
+    void reparent(entity_type entity, entity_type parent) {
+        assert(entity == parent || !descendant(parent, entity));
+        const auto pos = underlying_type::get(entity);
+
+        detach(entity);
+        nodes[pos].parent = parent;
+
+        if(parent != entity) {
+            const auto other = underlying_type::get(parent);
+            ++nodes[other].children;
+
+            if(pos < other) {
+                // the subtree moves after the rest of the range, both keep their order
+                const auto *direct = underlying_type::data();
+                const auto last = underlying_type::size();
+                std::vector<bool> subtree(last - pos, false);
+                std::vector<entity_type> rest;
+                std::vector<entity_type> moved;
+                subtree[0] = true;
+
+                for(auto curr = pos; curr < last; ++curr) {
+                    if(curr != pos) {
+                        const auto owner = nodes[curr].parent;
+                        const auto at = underlying_type::get(owner);
+                        subtree[curr - pos] = (owner != direct[curr]) && (at >= pos) && subtree[at - pos];
+                    }
+
+                    (subtree[curr - pos] ? moved : rest).push_back(direct[curr]);
+                }
+
+                rest.insert(rest.end(), moved.cbegin(), moved.cend());
+
+                for(size_type curr = 0; curr < rest.size(); ++curr) {
+                    if(direct[pos + curr] != rest[curr]) {
+                        Hierarchy::swap(direct[pos + curr], rest[curr]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Removes an entity from a hierarchy.
+     *
+     * Children of the entity become roots. If the entity is a leaf and the last
+     * element of the packed array can take its place, this is a constant time
+     * operation. Otherwise the cost is linear in the number of elements that
+     * follow the entity.
+     *
+     * @warning
+     * Attempting to remove an entity that doesn't belong to the hierarchy
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * hierarchy doesn't contain the given entity.
+     *
+     * @param entity A valid entity identifier.
+     */
+    void destroy(entity_type entity) override {
+        const auto *direct = underlying_type::data();
+        const auto pos = underlying_type::get(entity);
+        const auto last = underlying_type::size() - 1;
+
+        if(nodes[pos].children) {
+            for(auto curr = pos + 1; curr <= last; ++curr) {
+                if(nodes[curr].parent == entity) {
+                    nodes[curr].parent = direct[curr];
+                }
+            }
+        }
+
+        detach(entity);
+
+        if(pos != last) {
+            const auto back = nodes[last].parent;
+
+            if(back == direct[last] || underlying_type::get(back) < pos) {
+                // the last element has no children, it can replace the entity
+                nodes[pos] = nodes[last];
+            } else {
+                for(auto curr = pos; curr < last; ++curr) {
+                    Hierarchy::swap(direct[curr], direct[curr + 1]);
+                }
+            }
+        }
+
+        nodes.pop_back();
+        underlying_type::destroy(entity);
+    }
+
+    /**
+     * @brief Iterates entities and their parents, parents first.
+     *
+     * The function object is invoked for each entity in the hierarchy. It's
+     * guaranteed that an entity is returned only after its parent.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(entity_type entity, entity_type parent);
+     * @endcode
+     *
+     * Where roots are their own parents.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) const {
+        const auto *direct = underlying_type::data();
+
+        for(size_type pos = 0, last = underlying_type::size(); pos < last; ++pos) {
+            func(direct[pos], nodes[pos].parent);
+        }
+    }
+
+    /**
+     * @brief Returns the memory statistics of a hierarchy.
+     * @return The memory statistics of the hierarchy, nodes included.
+     */
+    SparseSetStats stats() const noexcept override {
+        auto result = underlying_type::stats();
+        result.instances = nodes.capacity() * sizeof(Node);
+        return result;
+    }
+
+    /**
+     * @brief Increases the capacity of a hierarchy.
+     * @param cap Desired capacity.
+     */
+    void reserve(size_type cap) override {
+        underlying_type::reserve(cap);
+        nodes.reserve(cap);
+    }
+
+    /**
+     * @brief Releases the memory that a hierarchy doesn't use.
+     */
+    void shrink_to_fit() override {
+        underlying_type::shrink_to_fit();
+        nodes.shrink_to_fit();
+    }
+
+    /**
+     * @brief Resets a hierarchy.
+     */
+    void reset() override {
+        underlying_type::reset();
+        nodes.clear();
+    }
+
+private:
+    std::vector<Node> nodes;
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_HIERARCHY_HPP
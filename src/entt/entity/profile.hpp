@@ -0,0 +1,13 @@
+#ifndef ENTT_ENTITY_PROFILE_HPP
+#define ENTT_ENTITY_PROFILE_HPP
+
+
+#if defined ENTT_PROFILING
+#include "profiler.hpp"
+#define ENTT_PROFILE(event, ...) entt::Profile<__VA_ARGS__> entt_profile_scope{entt::ProfileEvent::event}
+#else
+#define ENTT_PROFILE(event, ...)
+#endif
+
+
+#endif // ENTT_ENTITY_PROFILE_HPP
@@ -0,0 +1,369 @@
+#ifndef ENTT_ENTITY_PROFILER_HPP
+#define ENTT_ENTITY_PROFILER_HPP
+
+
+#include <unordered_map>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include "../core/type_hash.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Operations tracked by the profiler.
+ *
+ * * `CREATE`: entities created.
+ * * `DESTROY`: entities destroyed, either one at a time or by range.
+ * * `ASSIGN`: components assigned, also when entities are created with them.
+ * * `REMOVE`: components removed.
+ * * `SORT`: pools of components sorted.
+ * * `VIEW`: views constructed, either standard or persistent.
+ * * `EACH`: iterations performed by means of the `each` member function of a
+ *   view.
+ */
+enum class ProfileEvent: unsigned int {
+    CREATE = 0,
+    DESTROY,
+    ASSIGN,
+    REMOVE,
+    SORT,
+    VIEW,
+    EACH
+};
+
+
+/**
+ * @brief Collects counters and timings of registries and views.
+ *
+ * Registries and views report their operations to the profiler only if
+ * `ENTT_PROFILING` is defined before to include them. Otherwise the hooks
+ * compile away entirely, the profiler isn't even included and doesn't collect
+ * anything.<br/>
+ * Operations are counted per type: the component for assignments, removals and
+ * sorts, the registry for creations and destructions, the view for
+ * constructions and iterations.
+ *
+ * Timing is disabled by default. Once enabled, every operation is also
+ * recorded as a complete event that can be exported in the Chrome trace event
+ * format, to be opened with `chrome://tracing` or any other local trace viewer:
+ *
+ * @code{.cpp}
+ * entt::Profiler::instance().timing(true);
+ * // ...
+ * std::ofstream out{"trace.json"};
+ * entt::Profiler::instance().trace(out);
+ * @endcode
+ *
+ * @note
+ * The profiler is thread safe, operations performed on different threads are
+ * recorded on different tracks. Each thread accumulates its operations in a
+ * buffer of its own and buffers are merged only when they are reported, so
+ * that threads don't contend for a lock while they are recorded.
+ */
+class Profiler final {
+    using clock_type = std::chrono::steady_clock;
+    using hash_type = HashedString::hash_type;
+
+    using key_type = std::pair<hash_type, unsigned int>;
+
+    struct KeyHash final {
+        std::size_t operator()(const key_type &key) const noexcept {
+            return std::size_t(key.first ^ (hash_type(key.second) * 1099511628211u));
+        }
+    };
+
+    struct Record final {
+        key_type key;
+        std::string name;
+        ProfileEvent event;
+        std::size_t count;
+        std::chrono::nanoseconds elapsed;
+    };
+
+    struct Trace final {
+        std::size_t record;
+        std::chrono::nanoseconds start;
+        std::chrono::nanoseconds duration;
+    };
+
+    struct Buffer final {
+        // contended only while the operations of the thread are reported
+        std::mutex mutex{};
+        std::unordered_map<key_type, std::size_t, KeyHash> lookup{};
+        std::vector<Record> records{};
+        std::vector<Trace> traces{};
+    };
+
+    Profiler()
+        : epoch{clock_type::now()}
+    {}
+
+    static std::string pretty(const char *signature) {
+        // extracts the name of the type from the signature of Profile<Type>::name
+        std::string name{signature};
+        auto first = name.find("Type = ");
+
+        if(first != std::string::npos) {
+            first += 7;
+            name = name.substr(first, name.find_first_of(";]", first) - first);
+        } else if((first = name.find("Profile<")) != std::string::npos) {
+            first += 8;
+            name = name.substr(first, name.rfind(">::name") - first);
+        }
+
+        return name;
+    }
+
+    static void escape(std::ostream &out, const std::string &str) {
+        for(auto chr: str) {
+            if(chr == '"' || chr == '\\') {
+                out << '\\';
+            }
+
+            out << chr;
+        }
+    }
+
+    static const char * label(ProfileEvent event) noexcept {
+        static const char *labels[] = { "create", "destroy", "assign", "remove", "sort", "view", "each" };
+        return labels[static_cast<unsigned int>(event)];
+    }
+
+    Buffer & local() {
+        // the one and only profiler owns the buffers, threads only refer to them
+        static thread_local Buffer &buffer = [this]() -> Buffer & {
+            std::lock_guard<std::mutex> lock{mutex};
+            buffers.push_back(std::make_unique<Buffer>());
+            return *buffers.back();
+        }();
+
+        return buffer;
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Type used to store timestamps. */
+    using time_point = clock_type::time_point;
+
+    /*! @brief Copying a profiler isn't allowed. */
+    Profiler(const Profiler &) = delete;
+    /*! @brief Copying a profiler isn't allowed. @return This profiler. */
+    Profiler & operator=(const Profiler &) = delete;
+
+    /**
+     * @brief Returns the profiler shared by registries and views.
+     * @return The one and only profiler.
+     */
+    static Profiler & instance() noexcept {
+        static Profiler profiler{};
+        return profiler;
+    }
+
+    /**
+     * @brief Returns the current time as seen by the profiler.
+     * @return The current time if timing is enabled, a default constructed
+     * time point otherwise.
+     */
+    time_point now() const noexcept {
+        return timed ? clock_type::now() : time_point{};
+    }
+
+    /**
+     * @brief Checks whether operations are timed.
+     * @return True if timing is enabled, false otherwise.
+     */
+    bool timing() const noexcept {
+        return timed;
+    }
+
+    /**
+     * @brief Enables or disables timing of operations.
+     * @param value True to enable timing, false otherwise.
+     */
+    void timing(bool value) noexcept {
+        timed = value;
+    }
+
+    /**
+     * @brief Records an operation.
+     *
+     * This function is invoked by the hooks in registries and views. There
+     * should be no reasons to invoke it directly.
+     *
+     * @param type Identifier of the type the operation refers to.
+     * @param signature Signature from which to extract the name of the type.
+     * @param event The operation to record.
+     * @param start Time at which the operation started.
+     */
+    void record(hash_type type, const char *signature, ProfileEvent event, time_point start) {
+        const auto end = now();
+        auto &buffer = local();
+        std::lock_guard<std::mutex> lock{buffer.mutex};
+        const auto key = std::make_pair(type, static_cast<unsigned int>(event));
+        auto it = buffer.lookup.find(key);
+
+        if(it == buffer.lookup.end()) {
+            it = buffer.lookup.emplace(key, buffer.records.size()).first;
+            buffer.records.push_back(Record{key, pretty(signature), event, 0, std::chrono::nanoseconds{}});
+        }
+
+        auto &rec = buffer.records[it->second];
+        ++rec.count;
+
+        if(start != time_point{} && end != time_point{}) {
+            const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            rec.elapsed += duration;
+            buffer.traces.push_back(Trace{it->second, std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch), duration});
+        }
+    }
+
+    /**
+     * @brief Iterates the counters collected so far.
+     *
+     * The function object is invoked once for each pair of type and operation
+     * recorded. The signature of the function should be equivalent to the
+     * following:
+     *
+     * @code{.cpp}
+     * void(const std::string &name, ProfileEvent event, std::size_t count, std::chrono::nanoseconds elapsed);
+     * @endcode
+     *
+     * Where `elapsed` is the total time spent by the timed operations.<br/>
+     * Counters collected by different threads are merged before to invoke the
+     * function object.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) const {
+        std::unordered_map<key_type, std::size_t, KeyHash> lookup;
+        std::vector<Record> records;
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+
+            for(auto &&buffer: buffers) {
+                std::lock_guard<std::mutex> guard{buffer->mutex};
+
+                for(auto &&rec: buffer->records) {
+                    const auto it = lookup.find(rec.key);
+
+                    if(it == lookup.end()) {
+                        lookup.emplace(rec.key, records.size());
+                        records.push_back(rec);
+                    } else {
+                        records[it->second].count += rec.count;
+                        records[it->second].elapsed += rec.elapsed;
+                    }
+                }
+            }
+        }
+
+        for(auto &&rec: records) {
+            func(rec.name, rec.event, rec.count, rec.elapsed);
+        }
+    }
+
+    /**
+     * @brief Exports the timed operations in the Chrome trace event format.
+     * @param out An output stream to which to write the trace.
+     */
+    void trace(std::ostream &out) const {
+        std::lock_guard<std::mutex> lock{mutex};
+        bool first = true;
+
+        out << "{\"traceEvents\":[";
+
+        // threads are identified by the position of their buffers
+        for(std::size_t thread = 0; thread < buffers.size(); ++thread) {
+            auto &buffer = *buffers[thread];
+            std::lock_guard<std::mutex> guard{buffer.mutex};
+
+            for(auto &&trc: buffer.traces) {
+                const auto &rec = buffer.records[trc.record];
+                out << (first ? "" : ",") << "{\"name\":\"";
+                escape(out, rec.name);
+                out << "\",\"cat\":\"" << label(rec.event) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+                    << ",\"ts\":" << (trc.start.count() / 1000.) << ",\"dur\":" << (trc.duration.count() / 1000.) << '}';
+                first = false;
+            }
+        }
+
+        out << "],\"displayTimeUnit\":\"ns\"}";
+    }
+
+    /*! @brief Discards the counters and the operations recorded so far. */
+    void reset() {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        for(auto &&buffer: buffers) {
+            std::lock_guard<std::mutex> guard{buffer->mutex};
+            buffer->lookup.clear();
+            buffer->records.clear();
+            buffer->traces.clear();
+        }
+    }
+
+private:
+    const time_point epoch;
+    mutable std::mutex mutex{};
+    std::vector<std::unique_ptr<Buffer>> buffers{};
+    std::atomic<bool> timed{false};
+};
+
+
+/**
+ * @brief Scoped hook that reports an operation to the profiler.
+ *
+ * The operation is recorded when the hook goes out of scope. Use the
+ * `ENTT_PROFILE` macro rather than this class template, so that hooks compile
+ * away when `ENTT_PROFILING` isn't defined.
+ *
+ * @tparam Type Type the operation refers to.
+ */
+template<typename Type>
+struct Profile final {
+    /**
+     * @brief Starts tracking an operation.
+     * @param event The operation to track.
+     */
+    explicit Profile(ProfileEvent event) noexcept
+        : event{event}, start{Profiler::instance().now()}
+    {}
+
+    /*! @brief Copying a hook isn't allowed. */
+    Profile(const Profile &) = delete;
+    /*! @brief Copying a hook isn't allowed. @return This hook. */
+    Profile & operator=(const Profile &) = delete;
+
+    /*! @brief Reports the operation to the profiler. */
+    ~Profile() {
+        Profiler::instance().record(TypeHash<Type>::value(), name(), event, start);
+    }
+
+private:
+    static const char * name() noexcept {
+        return ENTT_PRETTY_FUNCTION;
+    }
+
+    const ProfileEvent event;
+    const Profiler::time_point start;
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_PROFILER_HPP
@@ -7,8 +7,16 @@
 #include <utility>
 #include <cstddef>
 #include <cassert>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 #include "../core/family.hpp"
+#include "../core/type_hash.hpp"
+#include "entity_storage.hpp"
+#include "profile.hpp"
 #include "sparse_set.hpp"
+#include "spatial_grid.hpp"
 #include "traits.hpp"
 #include "view.hpp"
 
@@ -16,6 +24,39 @@
 namespace entt {
 
 
+/**
+ * @brief Memory statistics of a registry.
+ *
+ * Footprints depend on the capacity of the internal arrays. Context variables,
+ * indexes and the memory allocated by the components on their own aren't taken
+ * in account.
+ */
+struct RegistryStats final {
+    /*! @brief Number of entities ever created. */
+    std::size_t entities;
+    /*! @brief Number of entities in the list of free identifiers. */
+    std::size_t available;
+    /*! @brief Number of pools of components. */
+    std::size_t pools;
+    /*! @brief Number of sets of entities of persistent views. */
+    std::size_t handlers;
+    /*! @brief Footprint of the entities. */
+    std::size_t base;
+    /*! @brief Footprint of the pools of components. */
+    std::size_t components;
+    /*! @brief Footprint of the sets of entities of persistent views. */
+    std::size_t views;
+
+    /**
+     * @brief Returns the total footprint of a registry.
+     * @return The number of bytes allocated by the registry.
+     */
+    std::size_t bytes() const noexcept {
+        return base + components + views;
+    }
+};
+
+
 /**
  * @brief Fast and reliable entity-component system.
  *
@@ -28,18 +69,100 @@ namespace entt {
  */
 template<typename Entity>
 class Registry {
-    using component_family = Family<struct InternalRegistryComponentFamily>;
     using view_family = Family<struct InternalRegistryViewFamily>;
     using traits_type = entt_traits<Entity>;
 
     template<typename Component>
-    struct Pool: SparseSet<Entity, Component> {
+    struct BaseIndex {
+        BaseIndex(HashedString::hash_type type)
+            : type{type}
+        {}
+
+        virtual ~BaseIndex() = default;
+        virtual void construct(Entity, const Component &) = 0;
+        virtual void replace(Entity, const Component &, const Component &) = 0;
+        virtual void destroy(Entity, const Component &) = 0;
+        virtual void reset() = 0;
+
+        const HashedString::hash_type type;
+    };
+
+    template<typename Component, typename Key>
+    struct Index final: BaseIndex<Component> {
+        template<typename Func>
+        Index(Func func)
+            : BaseIndex<Component>{TypeHash<Key>::value()}, key{std::move(func)}, entities{}
+        {}
+
+        void construct(Entity entity, const Component &component) override {
+            const auto result = entities.emplace(key(component), entity);
+            // keys must be unique, an entity would hide another one otherwise
+            assert(result.second);
+            (void)result;
+        }
+
+        void replace(Entity entity, const Component &previous, const Component &component) override {
+            const auto other = key(previous);
+
+            if(other != key(component)) {
+                entities.erase(other);
+                construct(entity, component);
+            }
+        }
+
+        void destroy(Entity, const Component &component) override {
+            entities.erase(key(component));
+        }
+
+        void reset() override {
+            entities.clear();
+        }
+
+        std::function<Key(const Component &)> key;
+        std::unordered_map<Key, Entity> entities;
+    };
+
+    template<typename Component, typename Type>
+    struct Grid final: BaseIndex<Component> {
+        template<typename Func>
+        Grid(Type size, Func func)
+            : BaseIndex<Component>{TypeHash<Grid>::value()}, position{std::move(func)}, grid{size}
+        {}
+
+        void construct(Entity entity, const Component &component) override {
+            const auto coords = position(component);
+            grid.construct(entity, coords.first, coords.second);
+        }
+
+        void replace(Entity entity, const Component &, const Component &component) override {
+            const auto coords = position(component);
+            grid.update(entity, coords.first, coords.second);
+        }
+
+        void destroy(Entity entity, const Component &) override {
+            grid.destroy(entity);
+        }
+
+        void reset() override {
+            grid.reset();
+        }
+
+        std::function<std::pair<Type, Type>(const Component &)> position;
+        SpatialGrid<Entity, Type> grid;
+    };
+
+    template<typename Component>
+    struct Pool final: SparseSet<Entity, Component> {
         using test_fn_type = bool(Registry::*)(Entity) const;
 
         template<typename... Args>
         Component & construct(Registry &registry, Entity entity, Args&&... args) {
             auto &component = SparseSet<Entity, Component>::construct(entity, std::forward<Args>(args)...);
 
+            observe([entity, &component](auto &observer) {
+                observer.construct(entity, component);
+            });
+
             for(auto &&listener: listeners) {
                 if((registry.*listener.second)(entity)) {
                     listener.first.construct(entity);
@@ -49,14 +172,68 @@ class Registry {
             return component;
         }
 
+        template<typename... Args>
+        Component & replace(Entity entity, Args&&... args) {
+            auto &component = this->get(entity);
+            Component other{std::forward<Args>(args)...};
+
+            observe([entity, &component, &other](auto &observer) {
+                observer.replace(entity, component, other);
+            });
+
+            component = std::move(other);
+            return component;
+        }
+
         void destroy(Entity entity) override {
-            SparseSet<Entity, Component>::destroy(entity);
+            auto &component = this->get(entity);
+
+            observe([entity, &component](auto &observer) {
+                observer.destroy(entity, component);
+            });
+
+            erase(entity);
+        }
+
+        void reset() override {
+            SparseSet<Entity, Component>::reset();
+
+            // keys and positions are dropped, indexes stay attached to the pool
+            observe([](auto &observer) {
+                observer.reset();
+            });
+        }
+
+        Component extract(Entity entity) {
+            auto &component = this->get(entity);
+
+            // keys are dropped while the component is still in a valid state
+            observe([entity, &component](auto &observer) {
+                observer.destroy(entity, component);
+            });
+
+            Component other{std::move(component)};
+            erase(entity);
+            return other;
+        }
+
+        template<typename It>
+        void batch(Registry &registry, It first, It last, const Component &value) {
+            SparseSet<Entity, Component>::batch(first, last, value);
+
+            observe([first, last, &value](auto &observer) {
+                for(auto it = first; it != last; ++it) {
+                    observer.construct(*it, value);
+                }
+            });
 
             for(auto &&listener: listeners) {
                 auto &handler = listener.first;
 
-                if(handler.has(entity)) {
-                    handler.destroy(entity);
+                for(auto it = first; it != last; ++it) {
+                    if((registry.*listener.second)(*it)) {
+                        handler.construct(*it);
+                    }
                 }
             }
         }
@@ -65,20 +242,147 @@ class Registry {
             listeners.emplace_back(handler, fn);
         }
 
+        inline bool observed() const noexcept {
+            return !listeners.empty();
+        }
+
+        // an index and a spatial index can be attached to a pool at once
+        std::unique_ptr<BaseIndex<Component>> index;
+        std::unique_ptr<BaseIndex<Component>> grid;
+
     private:
+        template<typename Func>
+        void observe(Func func) {
+            if(index) {
+                func(*index);
+            }
+
+            if(grid) {
+                func(*grid);
+            }
+        }
+
+        void erase(Entity entity) {
+            SparseSet<Entity, Component>::destroy(entity);
+
+            for(auto &&listener: listeners) {
+                auto &handler = listener.first;
+
+                if(handler.has(entity)) {
+                    handler.destroy(entity);
+                }
+            }
+        }
+
         std::vector<std::pair<SparseSet<Entity> &, test_fn_type>> listeners;
     };
 
+    struct PoolHandler final {
+        using instance_type = std::unique_ptr<SparseSet<Entity>>;
+        using clone_fn_type = void(*)(Registry &, const SparseSet<Entity> &, Entity, const Entity *, const Entity *);
+        using transfer_fn_type = void(*)(Registry &, SparseSet<Entity> &, const Entity *, const Entity *, const Entity *);
+        using destroy_fn_type = void(*)(SparseSet<Entity> &, const Entity *, const Entity *);
+        using unused_fn_type = bool(*)(const SparseSet<Entity> &);
+
+        instance_type pool;
+        clone_fn_type clone;
+        transfer_fn_type transfer;
+        destroy_fn_type destroy;
+        unused_fn_type unused;
+        HashedString::hash_type type;
+    };
+
+    template<typename Component>
+    static bool unused(const SparseSet<Entity> &set) {
+        // pools that feed indexes or persistent views or that have a custom
+        // deletion policy must stay around, recreating them would lose state
+        const auto &cpool = static_cast<const Pool<Component> &>(set);
+        return cpool.empty() && !cpool.index && !cpool.grid && !cpool.observed() && cpool.policy() == DeletionPolicy::SWAP_AND_POP;
+    }
+
+    template<typename Component>
+    static void destroy(SparseSet<Entity> &set, const Entity *first, const Entity *last) {
+        // pools are final classes, calls to destroy are resolved statically
+        auto &cpool = static_cast<Pool<Component> &>(set);
+
+        for(; first != last; ++first) {
+            if(cpool.has(*first)) {
+                cpool.destroy(*first);
+            }
+        }
+    }
+
+    template<typename Component>
+    static void transfer(Registry &registry, SparseSet<Entity> &set, const Entity *first, const Entity *last, const Entity *dest) {
+        auto &other = static_cast<Pool<Component> &>(set);
+        std::vector<std::size_t> matches;
+
+        for(auto it = first; it != last; ++it) {
+            if(other.has(*it)) {
+                matches.push_back(it - first);
+            }
+        }
+
+        if(!matches.empty()) {
+            auto &cpool = registry.ensure<Component>();
+            cpool.reserve(cpool.length() + matches.size());
+
+            for(auto pos: matches) {
+                cpool.construct(registry, dest[pos], other.extract(first[pos]));
+            }
+        }
+    }
+
+    template<typename Component>
+    static void clone(Registry &registry, const SparseSet<Entity> &set, Entity prototype, const Entity *first, const Entity *last) {
+        // a copy protects the prototype from reallocations of the target pool
+        const Component component = static_cast<const Pool<Component> &>(set).get(prototype);
+        auto &cpool = registry.ensure<Component>();
+        cpool.reserve(cpool.length() + (last - first));
+        cpool.batch(registry, first, last, component);
+    }
+
+    template<typename Component>
+    static constexpr std::enable_if_t<std::is_copy_constructible<Component>::value, typename PoolHandler::clone_fn_type>
+    cloner() noexcept {
+        return &clone<Component>;
+    }
+
+    template<typename Component>
+    static constexpr std::enable_if_t<!std::is_copy_constructible<Component>::value, typename PoolHandler::clone_fn_type>
+    cloner() noexcept {
+        return nullptr;
+    }
+
+    struct BaseWrapper {
+        virtual ~BaseWrapper() = default;
+    };
+
+    template<typename Type>
+    struct Wrapper final: BaseWrapper {
+        template<typename... Args>
+        Wrapper(Args&&... args)
+            : value{std::forward<Args>(args)...}
+        {}
+
+        Type value;
+    };
+
+    template<typename Type>
+    static constexpr auto identifier() noexcept {
+        return TypeHash<std::decay_t<Type>>::value();
+    }
+
     template<typename Component>
     bool managed() const noexcept {
-        const auto ctype = component_family::type<Component>();
-        return ctype < pools.size() && pools[ctype];
+        const auto ctype = types.find(identifier<Component>());
+        return ctype < pools.size() && pools[ctype].pool;
     }
 
     template<typename Component>
     const Pool<Component> & pool() const noexcept {
         assert(managed<Component>());
-        return static_cast<Pool<Component> &>(*pools[component_family::type<Component>()]);
+        return static_cast<Pool<Component> &>(*pools[types.find(identifier<Component>())].pool);
     }
 
     template<typename Component>
@@ -89,17 +393,28 @@ class Registry {
 
     template<typename Component>
     Pool<Component> & ensure() {
-        const auto ctype = component_family::type<Component>();
+        auto ctype = types.find(identifier<Component>());
 
-        if(!(ctype < pools.size())) {
-            pools.resize(ctype + 1);
-        }
+        // existing pools are looked up without modifying the registry
+        if(!(ctype < pools.size()) || !pools[ctype].pool) {
+            ctype = types.insert(identifier<Component>());
 
-        if(!pools[ctype]) {
-            pools[ctype] = std::make_unique<Pool<Component>>();
+            if(!(ctype < pools.size())) {
+                pools.resize(ctype + 1);
+            }
+
+            pools[ctype] = PoolHandler{std::make_unique<Pool<Component>>(), cloner<Component>(), &transfer<Component>, &destroy<Component>, &unused<Component>, identifier<Component>()};
         }
 
-        return pool<Component>();
+        return static_cast<Pool<Component> &>(*pools[ctype].pool);
+    }
+
+    template<typename Component, typename Type>
+    const SpatialGrid<Entity, Type> & spatial() const noexcept {
+        using grid_type = Grid<Component, Type>;
+        const auto &cpool = pool<Component>();
+        assert(cpool.grid && cpool.grid->type == TypeHash<grid_type>::value());
+        return static_cast<const grid_type &>(*cpool.grid).grid;
     }
 
     template<typename... Component>
@@ -167,7 +482,7 @@ public:
      * @return Number of entities still in use.
      */
     size_type size() const noexcept {
-        return entities.size() - available.size();
+        return entities.size();
     }
 
     /**
@@ -175,7 +490,23 @@ public:
      * @return Number of entities ever created.
      */
     size_type capacity() const noexcept {
-        return entities.size();
+        return entities.capacity();
+    }
+
+    /**
+     * @brief Increases the capacity of the pool for the given component.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated for the pool, otherwise this function does nothing. It's meant
+     * to be used to avoid reallocations when a known number of components is
+     * about to be assigned, as an example before to load a level.
+     *
+     * @tparam Component Type of component for which to reserve storage.
+     * @param cap Desired capacity.
+     */
+    template<typename Component>
+    void reserve(size_type cap) {
+        ensure<Component>().reserve(cap);
     }
 
     /**
@@ -186,7 +517,7 @@ public:
      */
     template<typename Component>
     bool empty() const noexcept {
-        return managed<Component>() ? pool<Component>().empty() : true;
+        return !size<Component>();
     }
 
     /**
@@ -194,7 +525,75 @@ public:
      * @return True if at least an entity is still in use, false otherwise.
      */
     bool empty() const noexcept {
-        return entities.size() == available.size();
+        return entities.empty();
+    }
+
+    /**
+     * @brief Returns the memory statistics of the pool of the given component.
+     *
+     * This is a constant time operation, it's cheap enough to be invoked once
+     * per frame.
+     *
+     * @tparam Component Type of component in which one is interested.
+     * @return The memory statistics of the pool, all zeros if the pool doesn't
+     * exist.
+     */
+    template<typename Component>
+    SparseSetStats stats() const noexcept {
+        return managed<Component>() ? pool<Component>().stats() : SparseSetStats{};
+    }
+
+    /**
+     * @brief Iterates the memory statistics of all the pools.
+     *
+     * The function object is invoked for each pool of components. The
+     * signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(HashedString::hash_type type, const SparseSetStats &stats);
+     * @endcode
+     *
+     * Where `type` is the identifier of the type of components as returned by
+     * `TypeHash`, stable between runs.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void stats(Func func) const {
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                func(handler.type, handler.pool->stats());
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the memory statistics of a registry.
+     *
+     * The cost is linear in the number of pools and persistent views, not in
+     * the number of entities.
+     *
+     * @return The memory statistics of the registry.
+     */
+    RegistryStats stats() const noexcept {
+        RegistryStats result{entities.capacity(), entities.available(), 0, 0, entities.bytes(), 0, 0};
+
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                ++result.pools;
+                result.components += handler.pool->stats().bytes();
+            }
+        }
+
+        for(auto &&handler: handlers) {
+            if(handler) {
+                ++result.handlers;
+                result.views += handler->stats().bytes();
+            }
+        }
+
+        return result;
     }
 
     /**
@@ -203,8 +602,7 @@ public:
      * @return True if the identifier is still valid, false otherwise.
      */
     bool valid(entity_type entity) const noexcept {
-        const auto entt = entity & traits_type::entity_mask;
-        return (entt < entities.size() && entities[entt] == entity);
+        return entities.valid(entity);
     }
 
     /**
@@ -213,7 +611,7 @@ public:
      * @return Version stored along with the given entity identifier.
      */
     version_type version(entity_type entity) const noexcept {
-        return version_type((entity >> traits_type::entity_shift) & traits_type::version_mask);
+        return EntityStorage<Entity>::version(entity);
     }
 
     /**
@@ -234,9 +632,7 @@ public:
      * @return Actual version for the given entity identifier.
      */
     version_type current(entity_type entity) const noexcept {
-        const auto entt = entity & traits_type::entity_mask;
-        assert(entt < entities.size());
-        return version_type((entities[entt] >> traits_type::entity_shift) & traits_type::version_mask);
+        return entities.current(entity);
     }
 
     /**
@@ -262,7 +658,7 @@ public:
     entity_type create(Component&&... components) noexcept {
         using accumulator_type = int[];
         const auto entity = create();
-        accumulator_type accumulator = { 0, (ensure<Component>().construct(*this, entity, std::forward<Component>(components)), 0)... };
+        accumulator_type accumulator = { 0, (assign<Component>(entity, std::forward<Component>(components)), 0)... };
         (void)accumulator;
         return entity;
     }
@@ -289,7 +685,7 @@ public:
     entity_type create() noexcept {
         using accumulator_type = int[];
         const auto entity = create();
-        accumulator_type accumulator = { 0, (ensure<Component>().construct(*this, entity), 0)... };
+        accumulator_type accumulator = { 0, (assign<Component>(entity), 0)... };
         (void)accumulator;
         return entity;
     }
@@ -312,19 +708,159 @@ public:
      * @return A valid entity identifier.
      */
     entity_type create() noexcept {
-        entity_type entity;
+        ENTT_PROFILE(CREATE, Registry);
+        return entities.create();
+    }
 
-        if(available.empty()) {
-            entity = entity_type(entities.size());
-            assert(entity < traits_type::entity_mask);
-            assert((entity >> traits_type::entity_shift) == entity_type{});
-            entities.push_back(entity);
-        } else {
-            entity = available.back();
-            available.pop_back();
+    /**
+     * @brief Creates new entities from a prototype that belongs to another
+     * registry.
+     *
+     * Each and every component of the prototype is copied to all the newly
+     * created entities. Pools are resized at most once and components are
+     * copied in bulk, therefore this function is much faster than creating the
+     * entities and assigning them the components one at a time.<br/>
+     * The identifiers of the newly created entities are written to the given
+     * output iterator.
+     *
+     * @note
+     * Components that aren't copy constructible are not cloned.
+     *
+     * @warning
+     * Attempting to use an invalid prototype results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid prototype.
+     *
+     * @tparam OutputIt Type of output iterator.
+     * @param other The registry that owns the prototype.
+     * @param prototype A valid entity identifier.
+     * @param count Number of entities to create.
+     * @param out An output iterator to which to write the new entities.
+     */
+    template<typename OutputIt>
+    void clone(const Registry &other, entity_type prototype, size_type count, OutputIt out) {
+        assert(other.valid(prototype));
+        std::vector<entity_type> instances;
+        instances.reserve(count);
+
+        for(size_type i = 0; i < count; ++i) {
+            instances.push_back(create());
         }
 
-        return entity;
+        const auto *first = instances.data();
+        const auto *last = first + instances.size();
+
+        for(size_type pos = 0, end = other.pools.size(); pos < end; ++pos) {
+            const auto &handler = other.pools[pos];
+
+            if(handler.pool && handler.clone && handler.pool->has(prototype)) {
+                handler.clone(*this, *handler.pool, prototype, first, last);
+            }
+        }
+
+        std::copy(first, last, out);
+    }
+
+    /**
+     * @brief Creates new entities from a prototype.
+     *
+     * Each and every component of the prototype is copied to all the newly
+     * created entities. Pools are resized at most once and components are
+     * copied in bulk, therefore this function is much faster than creating the
+     * entities and assigning them the components one at a time.<br/>
+     * The identifiers of the newly created entities are written to the given
+     * output iterator.
+     *
+     * @note
+     * Components that aren't copy constructible are not cloned.
+     *
+     * @warning
+     * Attempting to use an invalid prototype results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid prototype.
+     *
+     * @tparam OutputIt Type of output iterator.
+     * @param prototype A valid entity identifier.
+     * @param count Number of entities to create.
+     * @param out An output iterator to which to write the new entities.
+     */
+    template<typename OutputIt>
+    void clone(entity_type prototype, size_type count, OutputIt out) {
+        clone(*this, prototype, count, std::move(out));
+    }
+
+    /**
+     * @brief Moves a range of entities and their components from another
+     * registry.
+     *
+     * A new entity is created for each entity in the range and its components
+     * are moved (not copied) from the other registry. Pools are resized at
+     * most once for the whole range. Then the entities are destroyed in the
+     * other registry, that can freely recycle their identifiers.<br/>
+     * The identifiers of the newly created entities are written to the given
+     * output iterator, in the same order of the range.
+     *
+     * @warning
+     * Attempting to use invalid entities or to transfer entities from a
+     * registry to itself results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entities or if the two registries are the same.
+     *
+     * @tparam It Type of input iterator.
+     * @tparam OutputIt Type of output iterator.
+     * @param other The registry that owns the entities.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param out An output iterator to which to write the new entities.
+     */
+    template<typename It, typename OutputIt>
+    void transfer(Registry &other, It first, It last, OutputIt out) {
+        assert(&other != this);
+        const std::vector<entity_type> source(first, last);
+        std::vector<entity_type> instances;
+        instances.reserve(source.size());
+
+        for(auto entity: source) {
+            assert(other.valid(entity));
+            (void)entity;
+            instances.push_back(create());
+        }
+
+        for(size_type pos = 0, end = other.pools.size(); pos < end; ++pos) {
+            auto &handler = other.pools[pos];
+
+            if(handler.pool) {
+                handler.transfer(*this, *handler.pool, source.data(), source.data() + source.size(), instances.data());
+            }
+        }
+
+        other.destroy(source.cbegin(), source.cend());
+        std::copy(instances.cbegin(), instances.cend(), out);
+    }
+
+    /**
+     * @brief Moves an entity and its components from another registry.
+     *
+     * A new entity is created and the components are moved (not copied) from
+     * the other registry. Then the entity is destroyed in the other registry,
+     * that can freely recycle its identifier.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to transfer an entity from a
+     * registry to itself results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the two registries are the same.
+     *
+     * @param other The registry that owns the entity.
+     * @param entity A valid entity identifier.
+     * @return The identifier of the newly created entity.
+     */
+    entity_type transfer(Registry &other, entity_type entity) {
+        entity_type result;
+        transfer(other, &entity, &entity + 1, &result);
+        return result;
     }
 
     /**
@@ -343,21 +879,52 @@ public:
      * @param entity A valid entity identifier
      */
     void destroy(entity_type entity) {
-        assert(valid(entity));
+        ENTT_PROFILE(DESTROY, Registry);
+        entities.release(entity);
 
-        const auto entt = entity & traits_type::entity_mask;
-        const auto version = 1 + ((entity >> traits_type::entity_shift) & traits_type::version_mask);
-        const auto next = entt | (version << traits_type::entity_shift);
-        entities[entt] = next;
-        available.push_back(next);
+        for(auto &&handler: pools) {
+            auto &cpool = handler.pool;
 
-        for(auto &&cpool: pools) {
             if(cpool && cpool->has(entity)) {
                 cpool->destroy(entity);
             }
         }
     }
 
+    /**
+     * @brief Destroys a range of entities and lets the registry recycle the
+     * identifiers.
+     *
+     * Pools are visited only once for the whole range and entities are
+     * removed from each of them with no virtual calls, therefore this function
+     * is faster than destroying the entities one at a time.
+     *
+     * @warning
+     * Attempting to use invalid entities or ranges that contain duplicates
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entities.
+     *
+     * @tparam It Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<typename It>
+    void destroy(It first, It last) {
+        ENTT_PROFILE(DESTROY, Registry);
+        const std::vector<entity_type> range(first, last);
+
+        for(auto entity: range) {
+            entities.release(entity);
+        }
+
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                handler.destroy(*handler.pool, range.data(), range.data() + range.size());
+            }
+        }
+    }
+
     /**
      * @brief Assigns the given component to an entity.
      *
@@ -380,6 +947,7 @@ public:
      */
     template<typename Component, typename... Args>
     Component & assign(entity_type entity, Args&&... args) {
+        ENTT_PROFILE(ASSIGN, Component);
         assert(valid(entity));
         return ensure<Component>().construct(*this, entity, std::forward<Args>(args)...);
     }
@@ -399,6 +967,7 @@ public:
      */
     template<typename Component>
     void remove(entity_type entity) {
+        ENTT_PROFILE(REMOVE, Component);
         assert(valid(entity));
         pool<Component>().destroy(entity);
     }
@@ -488,7 +1057,7 @@ public:
     template<typename Component, typename... Args>
     Component & replace(entity_type entity, Args&&... args) {
         assert(valid(entity));
-        return (pool<Component>().get(entity) = Component{std::forward<Args>(args)...});
+        return pool<Component>().replace(entity, std::forward<Args>(args)...);
     }
 
     /**
@@ -524,10 +1093,174 @@ public:
         auto &cpool = ensure<Component>();
 
         return (cpool.has(entity)
-                ? (cpool.get(entity) = Component{std::forward<Args>(args)...})
+                ? cpool.replace(entity, std::forward<Args>(args)...)
                 : cpool.construct(*this, entity, std::forward<Args>(args)...));
     }
 
+    /**
+     * @brief Attaches an index to the pool of the given component.
+     *
+     * An index maps the keys extracted from the components to the entities
+     * that own them and gives constant time lookups (see `lookup`). It's kept
+     * up-to-date when components are assigned, replaced or removed. In case
+     * the pool already has an index, it's replaced with the new one. A spatial
+     * index attached to the same pool isn't affected (see `grid`).<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * Key(const Component &);
+     * @endcode
+     *
+     * Where `Key` is the type of the keys, for which a specialization of
+     * `std::hash` must exist.
+     *
+     * @warning
+     * Keys must be unique. Attempting to assign a component the key of which
+     * is already in use results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * duplicate keys.
+     *
+     * @warning
+     * Components modified in place (as an example, through `get` or a view)
+     * aren't reindexed. Use `replace` or `accomodate` to update them if they
+     * affect the key.
+     *
+     * @tparam Component Type of the components to index.
+     * @tparam Func Type of the function object to use to extract keys.
+     * @param func A valid function object.
+     */
+    template<typename Component, typename Func>
+    void index(Func func) {
+        using key_type = std::decay_t<decltype(func(std::declval<const Component &>()))>;
+        auto instance = std::make_unique<Index<Component, key_type>>(std::move(func));
+        auto &cpool = ensure<Component>();
+
+        for(auto entity: cpool) {
+            instance->construct(entity, cpool.get(entity));
+        }
+
+        cpool.index = std::move(instance);
+    }
+
+    /**
+     * @brief Finds the entity that owns a component with the given key.
+     *
+     * The returned pointer is invalidated as soon as the pool of the given
+     * component is modified.
+     *
+     * @warning
+     * Attempting to lookup a component that doesn't have an index or to use a
+     * type of key that differs from the one returned by the function used to
+     * create the index results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid requests.
+     *
+     * @tparam Component Type of the indexed components.
+     * @tparam Key Type of the key.
+     * @param key The key to lookup.
+     * @return A pointer to the entity if it exists, a null pointer otherwise.
+     */
+    template<typename Component, typename Key>
+    const entity_type * lookup(const Key &key) const {
+        const auto &cpool = pool<Component>();
+        assert(cpool.index && cpool.index->type == TypeHash<Key>::value());
+        const auto &entities = static_cast<const Index<Component, Key> &>(*cpool.index).entities;
+        const auto it = entities.find(key);
+        return it == entities.cend() ? nullptr : &it->second;
+    }
+
+
+    /**
+     * @brief Attaches a spatial index to the pool of the given component.
+     *
+     * The spatial index is a uniform grid (see SpatialGrid) that contains all
+     * the entities that own the given component. It's kept up-to-date when
+     * components are assigned, replaced or removed and it's used to perform
+     * proximity queries (see `query`). In case the pool already has a spatial
+     * index, it's replaced with the new one. An index attached to the same
+     * pool with `index` isn't affected and both are kept up-to-date.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * std::pair<Type, Type>(const Component &);
+     * @endcode
+     *
+     * Where the pair contains the horizontal and vertical coordinates of the
+     * component.
+     *
+     * @warning
+     * Components modified in place (as an example, through `get` or a view)
+     * aren't moved within the grid. Use `replace` or `accomodate` to update
+     * their positions.
+     *
+     * @tparam Component Type of the components to index.
+     * @tparam Type Type of coordinates.
+     * @tparam Func Type of the function object to use to extract positions.
+     * @param size Size of the side of the cells of the grid.
+     * @param func A valid function object.
+     */
+    template<typename Component, typename Type, typename Func>
+    void grid(Type size, Func func) {
+        auto instance = std::make_unique<Grid<Component, Type>>(size, std::move(func));
+        auto &cpool = ensure<Component>();
+
+        for(auto entity: cpool) {
+            instance->construct(entity, cpool.get(entity));
+        }
+
+        cpool.grid = std::move(instance);
+    }
+
+    /**
+     * @brief Finds the entities the positions of which are within an
+     * axis-aligned box.
+     *
+     * @warning
+     * Attempting to query a component that doesn't have a spatial index or to
+     * use a type of coordinates that differs from the one used to create the
+     * index results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid requests.
+     *
+     * @tparam Component Type of the indexed components.
+     * @tparam Type Type of coordinates.
+     * @tparam OutputIt Type of output iterator.
+     * @param minx Left side of the box.
+     * @param miny Bottom side of the box.
+     * @param maxx Right side of the box.
+     * @param maxy Top side of the box.
+     * @param out An output iterator to which to write the entities.
+     * @return An iterator past the last entity written.
+     */
+    template<typename Component, typename Type, typename OutputIt>
+    OutputIt query(Type minx, Type miny, Type maxx, Type maxy, OutputIt out) const {
+        return spatial<Component, Type>().query(minx, miny, maxx, maxy, std::move(out));
+    }
+
+    /**
+     * @brief Finds the entities the positions of which are within a circle.
+     *
+     * @warning
+     * Attempting to query a component that doesn't have a spatial index or to
+     * use a type of coordinates that differs from the one used to create the
+     * index results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid requests.
+     *
+     * @tparam Component Type of the indexed components.
+     * @tparam Type Type of coordinates.
+     * @tparam OutputIt Type of output iterator.
+     * @param x Horizontal coordinate of the center of the circle.
+     * @param y Vertical coordinate of the center of the circle.
+     * @param radius Radius of the circle.
+     * @param out An output iterator to which to write the entities.
+     * @return An iterator past the last entity written.
+     */
+    template<typename Component, typename Type, typename OutputIt>
+    OutputIt query(Type x, Type y, Type radius, OutputIt out) const {
+        return spatial<Component, Type>().query(x, y, radius, std::move(out));
+    }
+
     /**
      * @brief Sorts the pool of entities for the given component.
      *
@@ -555,6 +1288,7 @@ public:
      */
     template<typename Component, typename Compare>
     void sort(Compare compare) {
+        ENTT_PROFILE(SORT, Component);
         auto &cpool = ensure<Component>();
 
         cpool.sort([&cpool, compare = std::move(compare)](auto lhs, auto rhs) {
@@ -594,9 +1328,126 @@ public:
      */
     template<typename To, typename From>
     void sort() {
+        ENTT_PROFILE(SORT, To);
         ensure<To>().respect(ensure<From>());
     }
 
+    /**
+     * @brief Returns the deletion policy of the pool of the given component.
+     * @tparam Component Type of the component of which to return the policy.
+     * @return The deletion policy in use, the default one if the pool doesn't
+     * exist.
+     */
+    template<typename Component>
+    DeletionPolicy policy() const noexcept {
+        return managed<Component>() ? pool<Component>().policy() : DeletionPolicy::SWAP_AND_POP;
+    }
+
+    /**
+     * @brief Sets the deletion policy of the pool of the given component.
+     *
+     * With the tombstone policy, removing a component leaves a tombstone in
+     * its place and the other components don't change position. Therefore
+     * components can be freely removed during an iteration and references to
+     * components remain valid until the pool is compacted.<br/>
+     * Pools are compacted when switching back to the swap-and-pop policy.
+     *
+     * @tparam Component Type of the component of which to set the policy.
+     * @param pol The deletion policy to use from now on.
+     */
+    template<typename Component>
+    void policy(DeletionPolicy pol) {
+        ensure<Component>().policy(pol);
+    }
+
+    /**
+     * @brief Removes the tombstones from the pool of the given component.
+     *
+     * @warning
+     * Compacting a pool invalidates iterators and references to its
+     * components. Do not invoke this function during an iteration.
+     *
+     * @tparam Component Type of the component of which to compact the pool.
+     */
+    template<typename Component>
+    void compact() {
+        if(managed<Component>()) {
+            pool<Component>().compact();
+        }
+    }
+
+    /**
+     * @brief Removes the tombstones from all the pools.
+     *
+     * This is meant to be invoked at a safe point, as an example once per
+     * frame, after all the systems have run.
+     *
+     * @warning
+     * Compacting a pool invalidates iterators and references to its
+     * components. Do not invoke this function during an iteration.
+     */
+    void compact() {
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                handler.pool->compact();
+            }
+        }
+    }
+
+    /**
+     * @brief Releases the memory that the pool of the given component doesn't
+     * use.
+     *
+     * The pool is compacted, its sparse array is trimmed to the highest entity
+     * that has the component and the capacity of its packed arrays is reduced
+     * to fit their sizes.
+     *
+     * @warning
+     * Shrinking a pool invalidates iterators and references to its components.
+     * Do not invoke this function during an iteration.
+     *
+     * @tparam Component Type of the component of which to shrink the pool.
+     */
+    template<typename Component>
+    void shrink_to_fit() {
+        if(managed<Component>()) {
+            pool<Component>().shrink_to_fit();
+        }
+    }
+
+    /**
+     * @brief Releases the memory that a registry doesn't use.
+     *
+     * All the pools and the sets of entities of persistent views are shrunk to
+     * fit their sizes. Pools that are empty, aren't used by any index or
+     * persistent view and use the default deletion policy are destroyed, they
+     * are created again on demand.<br/>
+     * This is meant to be invoked after a mass destruction, as an example when
+     * a level is unloaded.
+     *
+     * @warning
+     * Shrinking a registry invalidates iterators and references to components,
+     * as well as standard views previously returned. Do not invoke this
+     * function during an iteration.
+     */
+    void shrink_to_fit() {
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                handler.pool->shrink_to_fit();
+
+                if(handler.unused(*handler.pool)) {
+                    handler.pool.reset();
+                }
+            }
+        }
+
+        for(auto &&handler: handlers) {
+            if(handler) {
+                handler->shrink_to_fit();
+            }
+        }
+    }
+
     /**
      * @brief Resets the given component for an entity.
      *
@@ -637,11 +1488,11 @@ public:
         if(managed<Component>()) {
             auto &cpool = pool<Component>();
 
-            for(auto entity: entities) {
+            each([&cpool](auto entity) {
                 if(cpool.has(entity)) {
                     cpool.destroy(entity);
                 }
-            }
+            });
         }
     }
 
@@ -652,16 +1503,60 @@ public:
      * previously created are recycled with a new version number. In case entity
      * identifers are stored around, the `current` member function can be used
      * to know if they are still valid.
+     *
+     * Pools that have an index or a spatial index, that are used by persistent
+     * views or that have a custom deletion policy are emptied but kept, as well
+     * as their configuration. The other pools are destroyed and created again
+     * on demand.
+     *
+     * @note
+     * Context variables aren't affected by a reset.
      */
     void reset() {
-        available.clear();
-        pools.clear();
+        for(auto &&handler: pools) {
+            if(handler.pool) {
+                handler.pool->reset();
+
+                if(handler.unused(*handler.pool)) {
+                    handler.pool.reset();
+                }
+            }
+        }
 
-        for(auto &&entity: entities) {
-            const auto version = 1 + ((entity >> traits_type::entity_shift) & traits_type::version_mask);
-            entity = (entity & traits_type::entity_mask) | (version << traits_type::entity_shift);
-            available.push_back(entity);
+        for(auto &&handler: handlers) {
+            if(handler) {
+                handler->reset();
+            }
         }
+
+        entities.reset();
+    }
+
+    /**
+     * @brief Iterates all the entities that are still in use.
+     *
+     * The function object is invoked for each entity that is still in use.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(entity_type);
+     * @endcode
+     *
+     * This function is fairly slow and should not be used frequently.<br/>
+     * Consider using a view if the goal is to iterate entities that have a
+     * determinate set of components. A view is usually faster than combining
+     * this function with a bunch of custom tests.
+     *
+     * @note
+     * Destroying the entity currently pointed during an iteration is allowed.
+     * Entities created during an iteration may or may not be returned.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) const {
+        entities.each(std::move(func));
     }
 
     /**
@@ -698,6 +1593,7 @@ public:
      */
     template<typename... Component>
     View<Entity, Component...> view() {
+        ENTT_PROFILE(VIEW, View<Entity, Component...>);
         return View<Entity, Component...>{ensure<Component>()...};
     }
 
@@ -761,14 +1657,117 @@ public:
      */
     template<typename... Component>
     PersistentView<Entity, Component...> persistent() {
+        ENTT_PROFILE(VIEW, PersistentView<Entity, Component...>);
         return PersistentView<Entity, Component...>{handler<Component...>(), ensure<Component>()...};
     }
 
+    /**
+     * @brief Binds an object to the context of the registry.
+     *
+     * In case the context already contains an instance of the given type, it
+     * is replaced with the newly created object.<br/>
+     * Context variables are meant for singletons and world-globals (as an
+     * example, the elapsed time or the state of the input devices). They
+     * aren't bound to any entity and don't require a pool, therefore they can
+     * be accessed in constant time with no extra indirections.
+     *
+     * @tparam Type Type of object to set.
+     * @tparam Args Types of arguments to use to construct the object.
+     * @param args Parameters to use to initialize the object.
+     * @return A reference to the newly created object.
+     */
+    template<typename Type, typename... Args>
+    Type & set(Args&&... args) {
+        const auto ctype = types.insert(identifier<Type>());
+
+        if(!(ctype < context.size())) {
+            context.resize(ctype + 1);
+        }
+
+        auto wrapper = std::make_unique<Wrapper<Type>>(std::forward<Args>(args)...);
+        auto &value = wrapper->value;
+        context[ctype] = std::move(wrapper);
+        return value;
+    }
+
+    /**
+     * @brief Unsets a context variable if it exists.
+     * @tparam Type Type of object to unset.
+     */
+    template<typename Type>
+    void unset() {
+        const auto ctype = types.find(identifier<Type>());
+
+        if(ctype < context.size()) {
+            context[ctype].reset();
+        }
+    }
+
+    /**
+     * @brief Returns a pointer to an object in the context of the registry.
+     * @tparam Type Type of object to get.
+     * @return A pointer to the object if it exists in the context of the
+     * registry, a null pointer otherwise.
+     */
+    template<typename Type>
+    const Type * try_ctx() const noexcept {
+        const auto ctype = types.find(identifier<Type>());
+        return (ctype < context.size() && context[ctype]) ? &static_cast<const Wrapper<Type> &>(*context[ctype]).value : nullptr;
+    }
+
+    /**
+     * @brief Returns a pointer to an object in the context of the registry.
+     * @tparam Type Type of object to get.
+     * @return A pointer to the object if it exists in the context of the
+     * registry, a null pointer otherwise.
+     */
+    template<typename Type>
+    Type * try_ctx() noexcept {
+        return const_cast<Type *>(const_cast<const Registry *>(this)->try_ctx<Type>());
+    }
+
+    /**
+     * @brief Returns a reference to an object in the context of the registry.
+     *
+     * @warning
+     * Attempting to get a context variable that doesn't exist results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid requests.
+     *
+     * @tparam Type Type of object to get.
+     * @return A valid reference to the object in the context of the registry.
+     */
+    template<typename Type>
+    const Type & ctx() const noexcept {
+        const auto *instance = try_ctx<Type>();
+        assert(instance);
+        return *instance;
+    }
+
+    /**
+     * @brief Returns a reference to an object in the context of the registry.
+     *
+     * @warning
+     * Attempting to get a context variable that doesn't exist results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid requests.
+     *
+     * @tparam Type Type of object to get.
+     * @return A valid reference to the object in the context of the registry.
+     */
+    template<typename Type>
+    Type & ctx() noexcept {
+        return const_cast<Type &>(const_cast<const Registry *>(this)->ctx<Type>());
+    }
+
 private:
+    HashIndex types;
+    std::vector<std::unique_ptr<BaseWrapper>> context;
     std::vector<std::unique_ptr<SparseSet<Entity>>> handlers;
-    std::vector<std::unique_ptr<SparseSet<Entity>>> pools;
-    std::vector<entity_type> available;
-    std::vector<entity_type> entities;
+    std::vector<PoolHandler> pools;
+    EntityStorage<Entity> entities;
 };
 
 
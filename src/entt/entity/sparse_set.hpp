@@ -3,6 +3,7 @@
 
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 #include <vector>
 #include <cstddef>
@@ -13,6 +14,64 @@
 namespace entt {
 
 
+/**
+ * @brief Policies for the removal of entities from sparse sets.
+ *
+ * * `SWAP_AND_POP`: the last element of the packed array takes the place of the
+ *   removed one. The packed array has no holes, but removing entities other than
+ *   the one currently pointed during an iteration isn't allowed.
+ * * `TOMBSTONE`: the removed element is replaced by a tombstone and nothing is
+ *   moved around until the sparse set is compacted. Entities can be freely
+ *   removed during iterations and objects don't change address.
+ */
+enum class DeletionPolicy: unsigned int {
+    SWAP_AND_POP = 0,
+    TOMBSTONE
+};
+
+
+/**
+ * @brief Memory statistics of a sparse set.
+ *
+ * Sizes are expressed in number of elements, footprints in bytes. Footprints
+ * depend on the capacity of the internal arrays and don't take in account the
+ * memory allocated by the objects on their own, if any.
+ */
+struct SparseSetStats final {
+    /*! @brief Number of entities in the sparse set, tombstones excluded. */
+    std::size_t size;
+    /*! @brief Number of tombstones in the internal packed array. */
+    std::size_t tombstones;
+    /*! @brief Capacity of the internal packed array. */
+    std::size_t capacity;
+    /*! @brief Number of slots of the internal sparse array. */
+    std::size_t extent;
+    /*! @brief Footprint of the internal sparse array. */
+    std::size_t sparse;
+    /*! @brief Footprint of the internal packed array. */
+    std::size_t packed;
+    /*! @brief Footprint of the objects associated to the entities. */
+    std::size_t instances;
+
+    /**
+     * @brief Returns the total footprint of a sparse set.
+     * @return The number of bytes allocated by the sparse set.
+     */
+    std::size_t bytes() const noexcept {
+        return sparse + packed + instances;
+    }
+
+    /**
+     * @brief Returns the fragmentation of the internal sparse array.
+     * @return The fraction of slots of the internal sparse array that don't
+     * refer to any entity, in the range `[0, 1]`.
+     */
+    double fragmentation() const noexcept {
+        return extent ? (1. - double(size) / double(extent)) : 0.;
+    }
+};
+
+
 /**
  * @brief Sparse set.
  *
@@ -57,12 +116,14 @@ class SparseSet<Entity> {
     struct Iterator {
         using value_type = Entity;
 
-        Iterator(const std::vector<Entity> *direct, std::size_t pos)
-            : direct{direct}, pos{pos}
-        {}
+        Iterator(const std::vector<Entity> *direct, std::size_t pos, bool holes)
+            : direct{direct}, pos{pos}, holes{holes}
+        {
+            skip();
+        }
 
         Iterator & operator++() noexcept {
-            return --pos, *this;
+            return --pos, skip(), *this;
         }
 
         Iterator operator++(int) noexcept {
@@ -83,8 +144,18 @@ class SparseSet<Entity> {
         }
 
     private:
+        void skip() noexcept {
+            // swap-and-pop sparse sets never contain tombstones
+            if(holes) {
+                while(pos && (*direct)[pos-1] == tombstone) {
+                    --pos;
+                }
+            }
+        }
+
         const std::vector<Entity> *direct;
         std::size_t pos;
+        bool holes;
     };
 
     static constexpr Entity in_use = 1 << traits_type::entity_shift;
@@ -99,6 +170,9 @@ public:
     /*! @brief Input iterator type. */
     using iterator_type = Iterator;
 
+    /*! @brief Placeholder for removed entities in the internal packed array. */
+    static constexpr entity_type tombstone = traits_type::entity_mask;
+
     /*! @brief Default constructor. */
     SparseSet() noexcept = default;
 
@@ -118,30 +192,132 @@ public:
     /**
      * @brief Returns the number of elements in a sparse set.
      *
-     * The number of elements is also the size of the internal packed array.
-     * There is no guarantee that the internal sparse array has the same size.
-     * Usually the size of the internal sparse array is equal or greater than
-     * the one of the internal packed array.
+     * Tombstones aren't elements and therefore they aren't counted. Use
+     * `length` to get the size of the internal packed array instead.
      *
      * @return Number of elements.
      */
     size_type size() const noexcept {
+        return direct.size() - dead;
+    }
+
+    /**
+     * @brief Returns the length of the internal packed array.
+     *
+     * The length is the number of elements plus the number of tombstones not
+     * yet removed by a compaction. There is no guarantee that the internal
+     * sparse array has the same size. Usually the size of the internal sparse
+     * array is equal or greater than the length of the internal packed array.
+     *
+     * @return Length of the internal packed array.
+     */
+    size_type length() const noexcept {
         return direct.size();
     }
 
+    /**
+     * @brief Returns the number of tombstones in a sparse set.
+     * @return Number of tombstones in the internal packed array.
+     */
+    size_type tombstones() const noexcept {
+        return dead;
+    }
+
+    /**
+     * @brief Returns the deletion policy of a sparse set.
+     * @return The deletion policy in use.
+     */
+    DeletionPolicy policy() const noexcept {
+        return deletion;
+    }
+
+    /**
+     * @brief Sets the deletion policy of a sparse set.
+     *
+     * The sparse set is compacted when switching back to the swap-and-pop
+     * policy.
+     *
+     * @param pol The deletion policy to use from now on.
+     */
+    void policy(DeletionPolicy pol) {
+        if(pol == DeletionPolicy::SWAP_AND_POP) {
+            compact();
+        }
+
+        deletion = pol;
+    }
+
     /**
      * @brief Checks whether a sparse set is empty.
      * @return True if the sparse set is empty, false otherwise.
      */
     bool empty() const noexcept {
-        return direct.empty();
+        return direct.size() == dead;
+    }
+
+    /**
+     * @brief Returns the memory statistics of a sparse set.
+     *
+     * This is a constant time operation, it's cheap enough to be invoked once
+     * per frame.
+     *
+     * @return The memory statistics of the sparse set.
+     */
+    virtual SparseSetStats stats() const noexcept {
+        return SparseSetStats{
+            direct.size() - dead,
+            dead,
+            direct.capacity(),
+            reverse.size(),
+            reverse.capacity() * sizeof(pos_type),
+            direct.capacity() * sizeof(entity_type),
+            0
+        };
+    }
+
+    /**
+     * @brief Increases the capacity of a sparse set.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated for the internal packed array, otherwise this function does
+     * nothing.
+     *
+     * @param cap Desired capacity.
+     */
+    virtual void reserve(size_type cap) {
+        direct.reserve(cap);
+    }
+
+    /**
+     * @brief Releases the memory that a sparse set doesn't use.
+     *
+     * The sparse set is compacted first, then the internal sparse array is
+     * trimmed to the highest entity it contains and the capacity of the
+     * internal packed array is reduced to its size.
+     *
+     * @warning
+     * Shrinking a sparse set invalidates its iterators. Do not invoke this
+     * function during an iteration.
+     */
+    virtual void shrink_to_fit() {
+        compact();
+        auto sz = reverse.size();
+
+        while(sz && !(reverse[sz-1] & in_use)) {
+            --sz;
+        }
+
+        reverse.resize(sz);
+        reverse.shrink_to_fit();
+        direct.shrink_to_fit();
     }
 
     /**
      * @brief Direct access to the internal packed array.
      *
-     * The returned pointer is such that range `[data(), data() + size()]` is
-     * always a valid range, even if the container is empty.
+     * The returned pointer is such that range `[data(), data() + length()]` is
+     * always a valid range, even if the container is empty. The range may
+     * contain tombstones if the sparse set isn't compacted.
      *
      * @note
      * There are no guarantees on the order, even though `sort` has been
@@ -164,12 +340,14 @@ public:
      * `end()`.
      *
      * @note
-     * Input iterators stay true to the order imposed by a call to `sort`.
+     * Input iterators stay true to the order imposed by a call to `sort` and
+     * skip tombstones. Iterators check for tombstones only if the sparse set
+     * uses the tombstone policy when they are created.
      *
      * @return An iterator to the first element of the internal packed array.
      */
     iterator_type begin() const noexcept {
-        return Iterator{&direct, direct.size()};
+        return Iterator{&direct, direct.size(), deletion == DeletionPolicy::TOMBSTONE};
     }
 
     /**
@@ -186,7 +364,7 @@ public:
      * internal packed array.
      */
     iterator_type end() const noexcept {
-        return Iterator{&direct, 0};
+        return Iterator{&direct, 0, deletion == DeletionPolicy::TOMBSTONE};
     }
 
     /**
@@ -244,9 +422,46 @@ public:
         direct.emplace_back(entity);
     }
 
+    /**
+     * @brief Assigns a range of entities to a sparse set.
+     *
+     * The internal arrays are resized at most once, no matter how many entities
+     * are assigned to the sparse set.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the sparse set
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * sparse set already contains any of the given entities.
+     *
+     * @tparam It Type of forward iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<typename It>
+    void batch(It first, It last) {
+        size_type sz = reverse.size();
+
+        for(auto it = first; it != last; ++it) {
+            sz = std::max(sz, size_type((*it & traits_type::entity_mask) + 1));
+        }
+
+        reverse.resize(sz, pos_type{});
+        direct.reserve(direct.size() + std::distance(first, last));
+
+        for(; first != last; ++first) {
+            assert(!has(*first));
+            reverse[*first & traits_type::entity_mask] = pos_type(direct.size()) | in_use;
+            direct.emplace_back(*first);
+        }
+    }
+
     /**
      * @brief Removes an entity from a sparse set.
      *
+     * With the tombstone policy, the entity is replaced by a tombstone and the
+     * other elements aren't moved around.
+     *
      * @warning
      * Attempting to remove an entity that doesn't belong to the sparse set
      * results in undefined behavior.<br/>
@@ -258,15 +473,48 @@ public:
     virtual void destroy(entity_type entity) {
         assert(has(entity));
         const auto entt = entity & traits_type::entity_mask;
-        const auto back = direct.back() & traits_type::entity_mask;
         const auto pos = reverse[entt] & ~in_use;
-        // the order matters: if back and entt are the same (for the sparse set
-        // has size 1), switching the two lines below doesn't work as expected
-        reverse[back] = pos | in_use;
-        reverse[entt] = pos;
-        // swap-and-pop the last element with the selected ont
-        direct[pos] = direct.back();
-        direct.pop_back();
+
+        if(deletion == DeletionPolicy::TOMBSTONE) {
+            reverse[entt] = pos;
+            direct[pos] = tombstone;
+            ++dead;
+        } else {
+            const auto back = direct.back() & traits_type::entity_mask;
+            // the order matters: if back and entt are the same (for the sparse set
+            // has size 1), switching the two lines below doesn't work as expected
+            reverse[back] = pos | in_use;
+            reverse[entt] = pos;
+            // swap-and-pop the last element with the selected ont
+            direct[pos] = direct.back();
+            direct.pop_back();
+        }
+    }
+
+    /**
+     * @brief Removes the tombstones from a sparse set.
+     *
+     * Remaining elements keep their relative order, therefore a previous call
+     * to `sort` or `respect` is still valid after a compaction.
+     *
+     * @warning
+     * Compacting a sparse set invalidates its iterators. Do not invoke this
+     * function during an iteration.
+     */
+    virtual void compact() {
+        if(dead) {
+            size_type to = 0;
+
+            for(auto entity: direct) {
+                if(entity != tombstone) {
+                    reverse[entity & traits_type::entity_mask] = pos_type(to) | in_use;
+                    direct[to++] = entity;
+                }
+            }
+
+            direct.resize(to);
+            dead = 0;
+        }
     }
 
     /**
@@ -305,22 +553,23 @@ public:
      * Attempting to iterate elements using the raw pointer returned by `data`
      * gives no guarantees on the order, even though `sort` has been invoked.
      *
+     * @note
+     * The sparse set is compacted before it's sorted.
+     *
      * @tparam Compare Type of the comparison function.
      * @param compare A comparison function whose signature shall be equivalent
      * to: `bool(Entity, Entity)`.
      */
     template<typename Compare>
     void sort(Compare compare) {
-        std::vector<pos_type> copy{direct.cbegin(), direct.cend()};
+        compact();
+        std::vector<entity_type> copy{direct.cbegin(), direct.cend()};
         std::sort(copy.begin(), copy.end(), [compare = std::move(compare)](auto... args) {
             return !compare(args...);
         });
 
-        for(pos_type i = 0; i < copy.size(); ++i) {
-            if(direct[i] != copy[i]) {
-                swap(direct[i], copy[i]);
-            }
-        }
+        // a single virtual call, elements are swapped with no indirections
+        arrange(copy);
     }
 
     /**
@@ -346,7 +595,7 @@ public:
         struct Bool { bool value{false}; };
         std::vector<Bool> check(std::max(other.reverse.size(), reverse.size()));
 
-        for(auto entity: other.direct) {
+        for(auto entity: other) {
             check[entity & traits_type::entity_mask].value = true;
         }
 
@@ -376,11 +625,32 @@ public:
     virtual void reset() {
         reverse.clear();
         direct.clear();
+        dead = 0;
+    }
+
+protected:
+    /**
+     * @brief Arranges the entities of a sparse set in the given order.
+     *
+     * Derived classes that attach data to the entities must override this
+     * function so as to rearrange their own data. It's invoked once per sort
+     * and it's meant to perform all the swaps without further virtual calls.
+     *
+     * @param order The entities of the sparse set in the expected order.
+     */
+    virtual void arrange(const std::vector<entity_type> &order) {
+        for(size_type pos = 0, last = order.size(); pos < last; ++pos) {
+            if(direct[pos] != order[pos]) {
+                SparseSet::swap(direct[pos], order[pos]);
+            }
+        }
     }
 
 private:
     std::vector<pos_type> reverse;
     std::vector<entity_type> direct;
+    size_type dead{};
+    DeletionPolicy deletion{DeletionPolicy::SWAP_AND_POP};
 };
 
 
@@ -438,8 +708,9 @@ public:
     /**
      * @brief Direct access to the array of objects.
      *
-     * The returned pointer is such that range `[raw(), raw() + size()]` is
-     * always a valid range, even if the container is empty.
+     * The returned pointer is such that range `[raw(), raw() + length()]` is
+     * always a valid range, even if the container is empty. Objects of removed
+     * entities are kept alive in place until the sparse set is compacted.
      *
      * @note
      * There are no guarantees on the order, even though `sort` has been
@@ -457,8 +728,9 @@ public:
     /**
      * @brief Direct access to the array of objects.
      *
-     * The returned pointer is such that range `[raw(), raw() + size()]` is
-     * always a valid range, even if the container is empty.
+     * The returned pointer is such that range `[raw(), raw() + length()]` is
+     * always a valid range, even if the container is empty. Objects of removed
+     * entities are kept alive in place until the sparse set is compacted.
      *
      * @note
      * There are no guarantees on the order, even though `sort` has been
@@ -526,9 +798,36 @@ public:
         return instances.back();
     }
 
+    /**
+     * @brief Assigns a range of entities to a sparse set and copies the given
+     * object for each of them.
+     *
+     * The internal arrays are resized at most once, no matter how many entities
+     * are assigned to the sparse set.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the sparse set
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * sparse set already contains any of the given entities.
+     *
+     * @tparam It Type of forward iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param value The object to copy for each entity.
+     */
+    template<typename It>
+    void batch(It first, It last, const type &value) {
+        instances.insert(instances.end(), std::distance(first, last), value);
+        underlying_type::batch(first, last);
+    }
+
     /**
      * @brief Removes an entity from a sparse set and destroies its object.
      *
+     * With the tombstone policy, the object is destroyed when the sparse set
+     * is compacted.
+     *
      * @warning
      * Attempting to use an entity that doesn't belong to the sparse set results
      * in undefined behavior.<br/>
@@ -538,12 +837,45 @@ public:
      * @param entity A valid entity identifier.
      */
     void destroy(entity_type entity) override {
-        // swaps isn't required here, we are getting rid of the last element
-        instances[underlying_type::get(entity)] = std::move(instances.back());
-        instances.pop_back();
+        if(underlying_type::policy() == DeletionPolicy::SWAP_AND_POP) {
+            // swaps isn't required here, we are getting rid of the last element
+            instances[underlying_type::get(entity)] = std::move(instances.back());
+            instances.pop_back();
+        }
+
         underlying_type::destroy(entity);
     }
 
+    /**
+     * @brief Removes the tombstones and the objects of removed entities from a
+     * sparse set.
+     *
+     * Remaining elements keep their relative order.
+     *
+     * @warning
+     * Compacting a sparse set invalidates its iterators as well as references
+     * to the objects. Do not invoke this function during an iteration.
+     */
+    void compact() override {
+        if(underlying_type::tombstones()) {
+            const auto *direct = underlying_type::data();
+            size_type to = 0;
+
+            for(size_type from = 0, last = underlying_type::length(); from < last; ++from) {
+                if(direct[from] != underlying_type::tombstone) {
+                    if(to != from) {
+                        instances[to] = std::move(instances[from]);
+                    }
+
+                    ++to;
+                }
+            }
+
+            instances.erase(instances.begin() + to, instances.end());
+            underlying_type::compact();
+        }
+    }
+
     /**
      * @brief Swaps two entities and their objects.
      *
@@ -565,6 +897,45 @@ public:
         underlying_type::swap(lhs, rhs);
     }
 
+    /**
+     * @brief Returns the memory statistics of a sparse set.
+     * @return The memory statistics of the sparse set, objects included.
+     */
+    SparseSetStats stats() const noexcept override {
+        auto result = underlying_type::stats();
+        result.instances = instances.capacity() * sizeof(type);
+        return result;
+    }
+
+    /**
+     * @brief Increases the capacity of a sparse set.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated both for the internal packed array and for the objects,
+     * otherwise this function does nothing.
+     *
+     * @param cap Desired capacity.
+     */
+    void reserve(size_type cap) override {
+        underlying_type::reserve(cap);
+        instances.reserve(cap);
+    }
+
+    /**
+     * @brief Releases the memory that a sparse set doesn't use.
+     *
+     * The sparse set is compacted first, then the capacities of the internal
+     * arrays and of the array of objects are reduced to fit their sizes.
+     *
+     * @warning
+     * Shrinking a sparse set invalidates its iterators as well as references to
+     * the objects. Do not invoke this function during an iteration.
+     */
+    void shrink_to_fit() override {
+        underlying_type::shrink_to_fit();
+        instances.shrink_to_fit();
+    }
+
     /**
      * @brief Resets a sparse set.
      */
@@ -573,6 +944,22 @@ public:
         instances.clear();
     }
 
+protected:
+    /**
+     * @brief Arranges entities and objects in the given order.
+     * @param order The entities of the sparse set in the expected order.
+     */
+    void arrange(const std::vector<entity_type> &order) override {
+        const auto *direct = underlying_type::data();
+
+        for(size_type pos = 0, last = order.size(); pos < last; ++pos) {
+            if(direct[pos] != order[pos]) {
+                std::swap(instances[pos], instances[underlying_type::get(order[pos])]);
+                underlying_type::swap(direct[pos], order[pos]);
+            }
+        }
+    }
+
 private:
     std::vector<type> instances;
 };
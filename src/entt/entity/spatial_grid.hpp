@@ -0,0 +1,295 @@
+#ifndef ENTT_ENTITY_SPATIAL_GRID_HPP
+#define ENTT_ENTITY_SPATIAL_GRID_HPP
+
+
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <cmath>
+#include "traits.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Uniform grid of entities.
+ *
+ * A spatial grid partitions a plane in square cells of the same size and
+ * assigns each entity to the cell that contains its position. Only cells that
+ * contain at least an entity are stored, therefore the plane is unbounded and
+ * the memory usage depends only on the number of entities.<br/>
+ * Proximity queries visit only the cells that overlap the area of interest,
+ * thus their cost depends on the density of the entities around and not on the
+ * total number of entities.
+ *
+ * @note
+ * As a rule of thumb, the size of the cells should be close to the radius of
+ * the most frequent queries.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Type Type of coordinates.
+ */
+template<typename Entity, typename Type = float>
+class SpatialGrid final {
+    using traits_type = entt_traits<Entity>;
+    using key_type = std::uint64_t;
+
+    struct Element final {
+        Entity entity;
+        Type x;
+        Type y;
+    };
+
+    struct Location final {
+        key_type key;
+        std::size_t pos;
+    };
+
+    static constexpr auto null = ~std::size_t{};
+
+    std::int64_t cell(Type value) const noexcept {
+        return std::int64_t(std::floor(double(value) * inverse));
+    }
+
+    static key_type key(std::int64_t cx, std::int64_t cy) noexcept {
+        // cells that share a key (if any) are filtered out by the queries
+        return (key_type(std::uint32_t(cx)) << 32) | key_type(std::uint32_t(cy));
+    }
+
+    template<typename Func>
+    void visit(Type minx, Type miny, Type maxx, Type maxy, Func func) const {
+        const auto fx = cell(minx);
+        const auto fy = cell(miny);
+        const auto lx = cell(maxx);
+        const auto ly = cell(maxy);
+
+        if(double(lx - fx + 1) * double(ly - fy + 1) > double(cells.size())) {
+            // the area is wider than the populated part of the plane
+            for(auto &&bucket: cells) {
+                for(auto &&element: bucket.second) {
+                    func(element);
+                }
+            }
+        } else {
+            for(auto cx = fx; cx <= lx; ++cx) {
+                for(auto cy = fy; cy <= ly; ++cy) {
+                    const auto it = cells.find(key(cx, cy));
+
+                    if(it != cells.cend()) {
+                        for(auto &&element: it->second) {
+                            func(element);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = typename traits_type::entity_type;
+    /*! @brief Type of coordinates. */
+    using coord_type = Type;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs an empty spatial grid.
+     * @param size Size of the side of the cells, it must be greater than zero.
+     */
+    explicit SpatialGrid(Type size)
+        : cells{}, locations{}, inverse{1. / double(size)}, count{}
+    {
+        assert(size > Type{});
+    }
+
+    /**
+     * @brief Returns the number of entities in a spatial grid.
+     * @return Number of entities.
+     */
+    size_type size() const noexcept {
+        return count;
+    }
+
+    /**
+     * @brief Checks whether a spatial grid is empty.
+     * @return True if the spatial grid is empty, false otherwise.
+     */
+    bool empty() const noexcept {
+        return !count;
+    }
+
+    /**
+     * @brief Checks if a spatial grid contains an entity.
+     * @param entity A valid entity identifier.
+     * @return True if the spatial grid contains the entity, false otherwise.
+     */
+    bool has(entity_type entity) const noexcept {
+        const auto entt = entity & traits_type::entity_mask;
+        return (entt < locations.size()) && (locations[entt].pos != null);
+    }
+
+    /**
+     * @brief Assigns an entity to a spatial grid.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the spatial grid
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * spatial grid already contains the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @param x Horizontal coordinate of the entity.
+     * @param y Vertical coordinate of the entity.
+     */
+    void construct(entity_type entity, Type x, Type y) {
+        assert(!has(entity));
+        const auto entt = entity & traits_type::entity_mask;
+
+        if(!(entt < locations.size())) {
+            locations.resize(entt+1, Location{key_type{}, null});
+        }
+
+        const auto ckey = key(cell(x), cell(y));
+        auto &bucket = cells[ckey];
+        locations[entt] = Location{ckey, bucket.size()};
+        bucket.push_back(Element{entity, x, y});
+        ++count;
+    }
+
+    /**
+     * @brief Removes an entity from a spatial grid.
+     *
+     * @warning
+     * Attempting to remove an entity that doesn't belong to the spatial grid
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * spatial grid doesn't contain the given entity.
+     *
+     * @param entity A valid entity identifier.
+     */
+    void destroy(entity_type entity) {
+        assert(has(entity));
+        auto &location = locations[entity & traits_type::entity_mask];
+        const auto it = cells.find(location.key);
+        auto &bucket = it->second;
+        // swap-and-pop the last element of the cell with the selected one
+        locations[bucket.back().entity & traits_type::entity_mask].pos = location.pos;
+        bucket[location.pos] = bucket.back();
+        bucket.pop_back();
+        location.pos = null;
+        --count;
+
+        if(bucket.empty()) {
+            cells.erase(it);
+        }
+    }
+
+    /**
+     * @brief Moves an entity within a spatial grid.
+     *
+     * Entities that don't change cell are updated in place.
+     *
+     * @warning
+     * Attempting to move an entity that doesn't belong to the spatial grid
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * spatial grid doesn't contain the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @param x New horizontal coordinate of the entity.
+     * @param y New vertical coordinate of the entity.
+     */
+    void update(entity_type entity, Type x, Type y) {
+        assert(has(entity));
+        const auto &location = locations[entity & traits_type::entity_mask];
+
+        if(location.key == key(cell(x), cell(y))) {
+            auto &element = cells.find(location.key)->second[location.pos];
+            element.x = x;
+            element.y = y;
+        } else {
+            destroy(entity);
+            construct(entity, x, y);
+        }
+    }
+
+    /**
+     * @brief Writes the entities within an axis-aligned box to an output
+     * iterator.
+     *
+     * Boundaries are part of the box. There are no guarantees on the order of
+     * the entities.
+     *
+     * @tparam OutputIt Type of output iterator.
+     * @param minx Left side of the box.
+     * @param miny Bottom side of the box.
+     * @param maxx Right side of the box.
+     * @param maxy Top side of the box.
+     * @param out An output iterator to which to write the entities.
+     * @return An iterator past the last entity written.
+     */
+    template<typename OutputIt>
+    OutputIt query(Type minx, Type miny, Type maxx, Type maxy, OutputIt out) const {
+        visit(minx, miny, maxx, maxy, [&](const auto &element) {
+            if(element.x >= minx && element.x <= maxx && element.y >= miny && element.y <= maxy) {
+                *out++ = element.entity;
+            }
+        });
+
+        return out;
+    }
+
+    /**
+     * @brief Writes the entities within a circle to an output iterator.
+     *
+     * Boundaries are part of the circle. There are no guarantees on the order
+     * of the entities.
+     *
+     * @tparam OutputIt Type of output iterator.
+     * @param x Horizontal coordinate of the center of the circle.
+     * @param y Vertical coordinate of the center of the circle.
+     * @param radius Radius of the circle.
+     * @param out An output iterator to which to write the entities.
+     * @return An iterator past the last entity written.
+     */
+    template<typename OutputIt>
+    OutputIt query(Type x, Type y, Type radius, OutputIt out) const {
+        const auto squared = double(radius) * double(radius);
+
+        visit(x - radius, y - radius, x + radius, y + radius, [&](const auto &element) {
+            const auto dx = double(element.x) - double(x);
+            const auto dy = double(element.y) - double(y);
+
+            if(dx * dx + dy * dy <= squared) {
+                *out++ = element.entity;
+            }
+        });
+
+        return out;
+    }
+
+    /**
+     * @brief Resets a spatial grid.
+     */
+    void reset() {
+        cells.clear();
+        locations.clear();
+        count = 0;
+    }
+
+private:
+    std::unordered_map<key_type, std::vector<Element>> cells;
+    std::vector<Location> locations;
+    double inverse;
+    size_type count;
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_SPATIAL_GRID_HPP
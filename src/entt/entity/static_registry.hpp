@@ -0,0 +1,729 @@
+#ifndef ENTT_ENTITY_STATIC_REGISTRY_HPP
+#define ENTT_ENTITY_STATIC_REGISTRY_HPP
+
+
+#include <tuple>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cassert>
+#include "../core/family.hpp"
+#include "../core/ident.hpp"
+#include "entity_storage.hpp"
+#include "profile.hpp"
+#include "sparse_set.hpp"
+#include "traits.hpp"
+#include "view.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Entity-component system specialized on a list of components.
+ *
+ * A static registry offers the same functionalities of a Registry (entities,
+ * components and views), but the set of components is fixed at compile-time
+ * and can't be extended afterwards. In exchange, all the pools are created
+ * along with the registry and stored in place, their positions are resolved at
+ * compile-time by means of `ident` and no virtual calls are involved when
+ * entities or components are created or destroyed.
+ *
+ * Use it when the types of components are known in advance and the hot path of
+ * a game or a simulation cannot afford the indirections of a Registry.
+ *
+ * @warning
+ * Attempting to use a type of component that isn't part of the list results
+ * in a compilation error.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Component Types of components managed by the registry.
+ */
+template<typename Entity, typename... Component>
+class StaticRegistry {
+    static_assert(sizeof...(Component) > 0, "!");
+
+    using view_family = Family<struct InternalStaticRegistryViewFamily>;
+    using traits_type = entt_traits<Entity>;
+
+    template<typename Comp>
+    struct Pool final: SparseSet<Entity, Comp> {
+        using test_fn_type = bool(StaticRegistry::*)(Entity) const;
+
+        template<typename... Args>
+        Comp & construct(StaticRegistry &registry, Entity entity, Args&&... args) {
+            auto &component = SparseSet<Entity, Comp>::construct(entity, std::forward<Args>(args)...);
+
+            for(auto &&listener: listeners) {
+                if((registry.*listener.second)(entity)) {
+                    listener.first.construct(entity);
+                }
+            }
+
+            return component;
+        }
+
+        void destroy(Entity entity) override {
+            SparseSet<Entity, Comp>::destroy(entity);
+
+            for(auto &&listener: listeners) {
+                auto &handler = listener.first;
+
+                if(handler.has(entity)) {
+                    handler.destroy(entity);
+                }
+            }
+        }
+
+        inline void append(SparseSet<Entity> &handler, test_fn_type fn) {
+            listeners.emplace_back(handler, fn);
+        }
+
+    private:
+        std::vector<std::pair<SparseSet<Entity> &, test_fn_type>> listeners;
+    };
+
+    template<typename Comp>
+    static constexpr std::size_t index() noexcept {
+        return ident<Component...>.template get<Comp>();
+    }
+
+    template<typename Comp>
+    const auto & pool() const noexcept {
+        return std::get<index<Comp>()>(pools);
+    }
+
+    template<typename Comp>
+    auto & pool() noexcept {
+        return std::get<index<Comp>()>(pools);
+    }
+
+    template<typename... Comp>
+    SparseSet<Entity> & handler() {
+        static_assert(sizeof...(Comp) > 1, "!");
+        const auto vtype = view_family::type<Comp...>();
+
+        if(!(vtype < handlers.size())) {
+            handlers.resize(vtype + 1);
+        }
+
+        if(!handlers[vtype]) {
+            using accumulator_type = int[];
+
+            auto set = std::make_unique<SparseSet<Entity>>();
+
+            for(auto entity: view<Comp...>()) {
+                set->construct(entity);
+            }
+
+            accumulator_type accumulator = {
+                (pool<Comp>().append(*set, &StaticRegistry::has<Comp...>), 0)...
+            };
+
+            handlers[vtype] = std::move(set);
+            (void)accumulator;
+        }
+
+        return *handlers[vtype];
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = typename traits_type::entity_type;
+    /*! @brief Underlying version type. */
+    using version_type = typename traits_type::version_type;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /*! @brief Default constructor. */
+    StaticRegistry() = default;
+
+    /*! @brief Copying a registry isn't allowed. */
+    StaticRegistry(const StaticRegistry &) = delete;
+    /*! @brief Default move constructor. */
+    StaticRegistry(StaticRegistry &&) = default;
+
+    /*! @brief Copying a registry isn't allowed. @return This registry. */
+    StaticRegistry & operator=(const StaticRegistry &) = delete;
+    /*! @brief Default move assignment operator. @return This registry. */
+    StaticRegistry & operator=(StaticRegistry &&) = default;
+
+    /**
+     * @brief Returns the number of existing components of the given type.
+     * @tparam Comp Type of component of which to return the size.
+     * @return Number of existing components of the given type.
+     */
+    template<typename Comp>
+    size_type size() const noexcept {
+        return pool<Comp>().size();
+    }
+
+    /**
+     * @brief Returns the number of entities still in use.
+     * @return Number of entities still in use.
+     */
+    size_type size() const noexcept {
+        return entities.size();
+    }
+
+    /**
+     * @brief Returns the number of entities ever created.
+     * @return Number of entities ever created.
+     */
+    size_type capacity() const noexcept {
+        return entities.capacity();
+    }
+
+    /**
+     * @brief Increases the capacity of the pool for the given component.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated for the pool, otherwise this function does nothing.
+     *
+     * @tparam Comp Type of component for which to reserve storage.
+     * @param cap Desired capacity.
+     */
+    template<typename Comp>
+    void reserve(size_type cap) {
+        pool<Comp>().reserve(cap);
+    }
+
+    /**
+     * @brief Checks whether the pool for the given component is empty.
+     * @tparam Comp Type of component in which one is interested.
+     * @return True if the pool for the given component is empty, false
+     * otherwise.
+     */
+    template<typename Comp>
+    bool empty() const noexcept {
+        return !size<Comp>();
+    }
+
+    /**
+     * @brief Checks if there exists at least an entity still in use.
+     * @return True if at least an entity is still in use, false otherwise.
+     */
+    bool empty() const noexcept {
+        return entities.empty();
+    }
+
+    /**
+     * @brief Returns the memory statistics of the pool of the given component.
+     *
+     * This is a constant time operation, it's cheap enough to be invoked once
+     * per frame.
+     *
+     * @tparam Comp Type of component in which one is interested.
+     * @return The memory statistics of the pool.
+     */
+    template<typename Comp>
+    SparseSetStats stats() const noexcept {
+        return pool<Comp>().stats();
+    }
+
+    /**
+     * @brief Verifies if an entity identifier still refers to a valid entity.
+     * @param entity An entity identifier, either valid or not.
+     * @return True if the identifier is still valid, false otherwise.
+     */
+    bool valid(entity_type entity) const noexcept {
+        return entities.valid(entity);
+    }
+
+    /**
+     * @brief Returns the version stored along with an entity identifier.
+     * @param entity An entity identifier, either valid or not.
+     * @return Version stored along with the given entity identifier.
+     */
+    version_type version(entity_type entity) const noexcept {
+        return EntityStorage<Entity>::version(entity);
+    }
+
+    /**
+     * @brief Returns the actual version for an entity identifier.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the registry results
+     * in undefined behavior. An entity belongs to the registry even if it has
+     * been previously destroyed and/or recycled.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * registry doesn't own the given entity.
+     *
+     * @param entity A valid entity identifier.
+     * @return Actual version for the given entity identifier.
+     */
+    version_type current(entity_type entity) const noexcept {
+        return entities.current(entity);
+    }
+
+    /**
+     * @brief Returns a new entity initialized with the given components.
+     * @tparam Comp A list of components to assign to the entity.
+     * @param components Instances with which to initialize components.
+     * @return A valid entity identifier.
+     */
+    template<typename... Comp>
+    entity_type create(Comp&&... components) noexcept {
+        using accumulator_type = int[];
+        const auto entity = create();
+        accumulator_type accumulator = { 0, (assign<Comp>(entity, std::forward<Comp>(components)), 0)... };
+        (void)accumulator;
+        return entity;
+    }
+
+    /**
+     * @brief Returns a new entity to which the given components are assigned.
+     * @tparam Comp A list of components to assign to the entity.
+     * @return A valid entity identifier.
+     */
+    template<typename... Comp>
+    entity_type create() noexcept {
+        using accumulator_type = int[];
+        const auto entity = create();
+        accumulator_type accumulator = { 0, (assign<Comp>(entity), 0)... };
+        (void)accumulator;
+        return entity;
+    }
+
+    /**
+     * @brief Creates a new entity and returns it.
+     *
+     * Entities are recycled the same way a Registry does. See
+     * `Registry::create` for further details.
+     *
+     * @return A valid entity identifier.
+     */
+    entity_type create() noexcept {
+        ENTT_PROFILE(CREATE, StaticRegistry);
+        return entities.create();
+    }
+
+    /**
+     * @brief Destroys an entity and lets the registry recycle the identifier.
+     *
+     * Pools are visited in the order in which components are listed and none
+     * of them is accessed through a virtual call.
+     *
+     * @warning
+     * Attempting to use an invalid entity results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity.
+     *
+     * @param entity A valid entity identifier
+     */
+    void destroy(entity_type entity) {
+        ENTT_PROFILE(DESTROY, StaticRegistry);
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (reset<Component>(entity), 0)... };
+        (void)accumulator;
+        entities.release(entity);
+    }
+
+    /**
+     * @brief Assigns the given component to an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to assign a component to an entity
+     * that already owns it results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the entity already owns an instance of the given
+     * component.
+     *
+     * @tparam Comp Type of the component to create.
+     * @tparam Args Types of arguments to use to construct the component.
+     * @param entity A valid entity identifier.
+     * @param args Parameters to use to initialize the component.
+     * @return A reference to the newly created component.
+     */
+    template<typename Comp, typename... Args>
+    Comp & assign(entity_type entity, Args&&... args) {
+        ENTT_PROFILE(ASSIGN, Comp);
+        assert(valid(entity));
+        return pool<Comp>().construct(*this, entity, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes the given component from an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to remove a component from an
+     * entity that doesn't own it results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the entity doesn't own an instance of the given
+     * component.
+     *
+     * @tparam Comp Type of the component to remove.
+     * @param entity A valid entity identifier.
+     */
+    template<typename Comp>
+    void remove(entity_type entity) {
+        ENTT_PROFILE(REMOVE, Comp);
+        assert(valid(entity));
+        pool<Comp>().destroy(entity);
+    }
+
+    /**
+     * @brief Checks if an entity has all the given components.
+     *
+     * @warning
+     * Attempting to use an invalid entity results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity.
+     *
+     * @tparam Comp Components for which to perform the check.
+     * @param entity A valid entity identifier.
+     * @return True if the entity has all the components, false otherwise.
+     */
+    template<typename... Comp>
+    bool has(entity_type entity) const noexcept {
+        static_assert(sizeof...(Comp) > 0, "!");
+        assert(valid(entity));
+        using accumulator_type = bool[];
+        bool all = true;
+        accumulator_type accumulator = { (all = all && pool<Comp>().has(entity))... };
+        (void)accumulator;
+        return all;
+    }
+
+    /**
+     * @brief Returns a reference to the given component for an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to get a component from an entity
+     * that doesn't own it results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the entity doesn't own an instance of the given
+     * component.
+     *
+     * @tparam Comp Type of the component to get.
+     * @param entity A valid entity identifier.
+     * @return A reference to the instance of the component owned by the entity.
+     */
+    template<typename Comp>
+    const Comp & get(entity_type entity) const noexcept {
+        assert(valid(entity));
+        return pool<Comp>().get(entity);
+    }
+
+    /**
+     * @brief Returns a reference to the given component for an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to get a component from an entity
+     * that doesn't own it results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the entity doesn't own an instance of the given
+     * component.
+     *
+     * @tparam Comp Type of the component to get.
+     * @param entity A valid entity identifier.
+     * @return A reference to the instance of the component owned by the entity.
+     */
+    template<typename Comp>
+    Comp & get(entity_type entity) noexcept {
+        return const_cast<Comp &>(const_cast<const StaticRegistry *>(this)->get<Comp>(entity));
+    }
+
+    /**
+     * @brief Replaces the given component for an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity or to replace a component of an
+     * entity that doesn't own it results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity or if the entity doesn't own an instance of the given
+     * component.
+     *
+     * @tparam Comp Type of the component to replace.
+     * @tparam Args Types of arguments to use to construct the component.
+     * @param entity A valid entity identifier.
+     * @param args Parameters to use to initialize the component.
+     * @return A reference to the newly created component.
+     */
+    template<typename Comp, typename... Args>
+    Comp & replace(entity_type entity, Args&&... args) {
+        assert(valid(entity));
+        return (pool<Comp>().get(entity) = Comp{std::forward<Args>(args)...});
+    }
+
+    /**
+     * @brief Assigns or replaces the given component for an entity.
+     *
+     * @warning
+     * Attempting to use an invalid entity results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity.
+     *
+     * @tparam Comp Type of the component to assign or replace.
+     * @tparam Args Types of arguments to use to construct the component.
+     * @param entity A valid entity identifier.
+     * @param args Parameters to use to initialize the component.
+     * @return A reference to the newly created component.
+     */
+    template<typename Comp, typename... Args>
+    Comp & accomodate(entity_type entity, Args&&... args) {
+        assert(valid(entity));
+        auto &cpool = pool<Comp>();
+
+        return (cpool.has(entity)
+                ? (cpool.get(entity) = Comp{std::forward<Args>(args)...})
+                : cpool.construct(*this, entity, std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Sorts the pool of entities for the given component.
+     *
+     * See `Registry::sort` for further details.
+     *
+     * @tparam Comp Type of the components to sort.
+     * @tparam Compare Type of the comparison function object.
+     * @param compare A valid comparison function object.
+     */
+    template<typename Comp, typename Compare>
+    void sort(Compare compare) {
+        ENTT_PROFILE(SORT, Comp);
+        auto &cpool = pool<Comp>();
+
+        cpool.sort([&cpool, compare = std::move(compare)](auto lhs, auto rhs) {
+            return compare(static_cast<const Comp &>(cpool.get(lhs)), static_cast<const Comp &>(cpool.get(rhs)));
+        });
+    }
+
+    /**
+     * @brief Sorts two pools of components in the same way.
+     *
+     * See `Registry::sort` for further details.
+     *
+     * @tparam To Type of the components to sort.
+     * @tparam From Type of the components to use to sort.
+     */
+    template<typename To, typename From>
+    void sort() {
+        ENTT_PROFILE(SORT, To);
+        pool<To>().respect(pool<From>());
+    }
+
+    /**
+     * @brief Returns the deletion policy of the pool of the given component.
+     * @tparam Comp Type of the component of which to return the policy.
+     * @return The deletion policy in use.
+     */
+    template<typename Comp>
+    DeletionPolicy policy() const noexcept {
+        return pool<Comp>().policy();
+    }
+
+    /**
+     * @brief Sets the deletion policy of the pool of the given component.
+     *
+     * With the tombstone policy, removing a component leaves a tombstone in
+     * its place and the other components don't change position. Therefore
+     * components can be freely removed during an iteration and references to
+     * components remain valid until the pool is compacted.<br/>
+     * Pools are compacted when switching back to the swap-and-pop policy.
+     *
+     * @tparam Comp Type of the component of which to set the policy.
+     * @param pol The deletion policy to use from now on.
+     */
+    template<typename Comp>
+    void policy(DeletionPolicy pol) {
+        pool<Comp>().policy(pol);
+    }
+
+    /**
+     * @brief Removes the tombstones from the pool of the given component.
+     *
+     * @warning
+     * Compacting a pool invalidates iterators and references to its
+     * components. Do not invoke this function during an iteration.
+     *
+     * @tparam Comp Type of the component of which to compact the pool.
+     */
+    template<typename Comp>
+    void compact() {
+        pool<Comp>().compact();
+    }
+
+    /**
+     * @brief Removes the tombstones from all the pools.
+     *
+     * This is meant to be invoked at a safe point, as an example once per
+     * frame, after all the systems have run.
+     *
+     * @warning
+     * Compacting a pool invalidates iterators and references to its
+     * components. Do not invoke this function during an iteration.
+     */
+    void compact() {
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (std::get<Pool<Component>>(pools).compact(), 0)... };
+        (void)accumulator;
+    }
+
+    /**
+     * @brief Releases the memory that a registry doesn't use.
+     *
+     * All the pools and the sets of entities of persistent views are compacted
+     * and shrunk to fit their sizes. Pools themselves are never destroyed.
+     *
+     * @warning
+     * Shrinking a registry invalidates iterators and references to components.
+     * Do not invoke this function during an iteration.
+     */
+    void shrink_to_fit() {
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (std::get<Pool<Component>>(pools).shrink_to_fit(), 0)... };
+        (void)accumulator;
+
+        for(auto &&handler: handlers) {
+            if(handler) {
+                handler->shrink_to_fit();
+            }
+        }
+    }
+
+    /**
+     * @brief Resets the given component for an entity.
+     *
+     * If the entity has an instance of the component, this function removes the
+     * component from the entity. Otherwise it does nothing.
+     *
+     * @warning
+     * Attempting to use an invalid entity results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * invalid entity.
+     *
+     * @tparam Comp Type of the component to reset.
+     * @param entity A valid entity identifier.
+     */
+    template<typename Comp>
+    void reset(entity_type entity) {
+        assert(valid(entity));
+        auto &cpool = pool<Comp>();
+
+        if(cpool.has(entity)) {
+            cpool.destroy(entity);
+        }
+    }
+
+    /**
+     * @brief Resets the pool of the given component.
+     *
+     * For each entity that has an instance of the given component, the
+     * component itself is removed and thus destroyed.
+     *
+     * @tparam Comp type of the component whose pool must be reset.
+     */
+    template<typename Comp>
+    void reset() {
+        auto &cpool = pool<Comp>();
+
+        // the last element is removed first, nothing is moved around
+        for(auto entity: cpool) {
+            cpool.destroy(entity);
+        }
+    }
+
+    /**
+     * @brief Resets a whole registry.
+     *
+     * Destroys all the entities. After a call to `reset`, all the entities
+     * previously created are recycled with a new version number. In case entity
+     * identifers are stored around, the `current` member function can be used
+     * to know if they are still valid.
+     */
+    void reset() {
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (std::get<Pool<Component>>(pools).reset(), 0)... };
+        (void)accumulator;
+
+        for(auto &&handler: handlers) {
+            if(handler) {
+                handler->reset();
+            }
+        }
+
+        entities.reset();
+    }
+
+    /**
+     * @brief Iterates all the entities that are still in use.
+     *
+     * The function object is invoked for each entity that is still in use.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(entity_type);
+     * @endcode
+     *
+     * @note
+     * Destroying the entity currently pointed during an iteration is allowed.
+     * Entities created during an iteration may or may not be returned.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) const {
+        entities.each(std::move(func));
+    }
+
+    /**
+     * @brief Returns a standard view for the given components.
+     *
+     * Views returned by a static registry are the same returned by a Registry.
+     * See `Registry::view` for further details.
+     *
+     * @see View
+     * @see View<Entity, Component>
+     *
+     * @tparam Comp Type of components used to construct the view.
+     * @return A newly created standard view.
+     */
+    template<typename... Comp>
+    View<Entity, Comp...> view() {
+        ENTT_PROFILE(VIEW, View<Entity, Comp...>);
+        return View<Entity, Comp...>{pool<Comp>()...};
+    }
+
+    /**
+     * @brief Prepares the internal data structures used by persistent views.
+     *
+     * See `Registry::prepare` for further details.
+     *
+     * @tparam Comp Types of components used to prepare the view.
+     */
+    template<typename... Comp>
+    void prepare() {
+        handler<Comp...>();
+    }
+
+    /**
+     * @brief Returns a persistent view for the given components.
+     *
+     * Views returned by a static registry are the same returned by a Registry.
+     * See `Registry::persistent` for further details.
+     *
+     * @see PersistentView
+     *
+     * @tparam Comp Types of components used to construct the view.
+     * @return A newly created persistent view.
+     */
+    template<typename... Comp>
+    PersistentView<Entity, Comp...> persistent() {
+        ENTT_PROFILE(VIEW, PersistentView<Entity, Comp...>);
+        return PersistentView<Entity, Comp...>{handler<Comp...>(), pool<Comp>()...};
+    }
+
+private:
+    std::tuple<Pool<Component>...> pools;
+    std::vector<std::unique_ptr<SparseSet<Entity>>> handlers;
+    EntityStorage<Entity> entities;
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_STATIC_REGISTRY_HPP
@@ -0,0 +1,312 @@
+#ifndef ENTT_ENTITY_SYSTEM_GRAPH_HPP
+#define ENTT_ENTITY_SYSTEM_GRAPH_HPP
+
+
+#include <condition_variable>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include "../core/hashed_string.hpp"
+#include "../core/type_hash.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Read-only access to a set of components.
+ *
+ * Tag type used to declare what are the components a system reads when it's
+ * attached to a system graph.
+ *
+ * @tparam Component Types of components read by a system.
+ */
+template<typename... Component>
+struct Read final {};
+
+
+/**
+ * @brief Read-write access to a set of components.
+ *
+ * Tag type used to declare what are the components a system writes when it's
+ * attached to a system graph.
+ *
+ * @tparam Component Types of components written by a system.
+ */
+template<typename... Component>
+struct Write final {};
+
+
+/**
+ * @brief Data-parallel graph of systems.
+ *
+ * A system graph runs a bunch of systems once per tick. Each system declares
+ * the components it reads and the ones it writes when attached to the graph.
+ * Two systems conflict if one of them writes a component that the other one
+ * either reads or writes. Conflicting systems are always executed in the same
+ * order in which they are attached, all the others run concurrently on a pool
+ * of threads owned by the graph.
+ *
+ * Example of use (pseudocode):
+ *
+ * @code{.cpp}
+ * graph.attach<entt::Read<Velocity>, entt::Write<Position>>([&registry](auto delta) {
+ *     registry.view<Position, Velocity>().each([delta](auto, auto &position, const auto &velocity) {
+ *         // ...
+ *     });
+ * });
+ * @endcode
+ *
+ * @warning
+ * The registry isn't thread safe. Systems can create views and access
+ * components concurrently, but they must not create or destroy entities, nor
+ * assign or remove components. Moreover, the pools of components must already
+ * exist when the graph is updated (as an example, create all the views once
+ * before the first update).
+ *
+ * @tparam Delta Type to use to provide elapsed time.
+ */
+template<typename Delta>
+class SystemGraph final {
+    using hash_type = HashedString::hash_type;
+
+    struct System final {
+        std::function<void(Delta)> func;
+        std::vector<hash_type> reads;
+        std::vector<hash_type> writes;
+        std::vector<std::size_t> next;
+        std::size_t prev;
+    };
+
+    template<typename... Component>
+    static void declare(System &system, Read<Component...>) {
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (system.reads.push_back(TypeHash<std::decay_t<Component>>::value()), 0)... };
+        (void)accumulator;
+    }
+
+    template<typename... Component>
+    static void declare(System &system, Write<Component...>) {
+        using accumulator_type = int[];
+        accumulator_type accumulator = { 0, (system.writes.push_back(TypeHash<std::decay_t<Component>>::value()), 0)... };
+        (void)accumulator;
+    }
+
+    static bool overlap(const std::vector<hash_type> &lhs, const std::vector<hash_type> &rhs) noexcept {
+        return std::any_of(lhs.cbegin(), lhs.cend(), [&rhs](auto type) {
+            return std::find(rhs.cbegin(), rhs.cend(), type) != rhs.cend();
+        });
+    }
+
+    static bool conflict(const System &lhs, const System &rhs) noexcept {
+        return overlap(lhs.writes, rhs.writes) || overlap(lhs.writes, rhs.reads) || overlap(lhs.reads, rhs.writes);
+    }
+
+    void complete(std::size_t pos) {
+        --pending;
+
+        for(auto other: systems[pos].next) {
+            if(!--counters[other]) {
+                ready.push_back(other);
+            }
+        }
+
+        cv.notify_all();
+    }
+
+    void run(std::unique_lock<std::mutex> &lock) {
+        const auto pos = ready.back();
+        ready.pop_back();
+        lock.unlock();
+        systems[pos].func(delta);
+        lock.lock();
+        complete(pos);
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock{mutex};
+
+        while(!stop) {
+            if(ready.empty()) {
+                cv.wait(lock);
+            } else {
+                run(lock);
+            }
+        }
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Type to use to provide elapsed time. */
+    using delta_type = Delta;
+
+    /**
+     * @brief Constructs a system graph and its pool of threads.
+     *
+     * The thread that invokes `update` takes part in the execution of the
+     * systems. Therefore the graph spawns only `concurrency - 1` workers.
+     *
+     * @param concurrency Maximum number of systems to run concurrently.
+     */
+    explicit SystemGraph(size_type concurrency = std::thread::hardware_concurrency())
+        : workers{}, systems{}, counters{}, ready{}, mutex{}, cv{}, delta{}, pending{}, stop{false}
+    {
+        for(size_type i = 1; i < concurrency; ++i) {
+            workers.emplace_back(&SystemGraph::work, this);
+        }
+    }
+
+    /*! @brief Stops and joins all the workers. */
+    ~SystemGraph() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+
+        cv.notify_all();
+
+        for(auto &&worker: workers) {
+            worker.join();
+        }
+    }
+
+    /*! @brief Copying a system graph isn't allowed. */
+    SystemGraph(const SystemGraph &) = delete;
+    /*! @brief Moving a system graph isn't allowed. */
+    SystemGraph(SystemGraph &&) = delete;
+
+    /*! @brief Copying a system graph isn't allowed. @return This graph. */
+    SystemGraph & operator=(const SystemGraph &) = delete;
+    /*! @brief Moving a system graph isn't allowed. @return This graph. */
+    SystemGraph & operator=(SystemGraph &&) = delete;
+
+    /**
+     * @brief Number of systems attached to the graph.
+     * @return Number of systems attached to the graph.
+     */
+    size_type size() const noexcept {
+        return systems.size();
+    }
+
+    /**
+     * @brief Returns true if no systems are attached to the graph.
+     * @return True if the graph has no systems, false otherwise.
+     */
+    bool empty() const noexcept {
+        return systems.empty();
+    }
+
+    /**
+     * @brief Number of threads that can run systems concurrently.
+     * @return Number of workers plus the thread that invokes `update`.
+     */
+    size_type concurrency() const noexcept {
+        return workers.size() + 1;
+    }
+
+    /**
+     * @brief Discards all the systems attached to the graph.
+     *
+     * @warning
+     * Clearing a graph during an update results in undefined behavior.
+     */
+    void clear() {
+        systems.clear();
+    }
+
+    /**
+     * @brief Attaches a system to the graph.
+     *
+     * Components accessed by the system are declared by means of a list of
+     * `Read` and `Write` tag types. The system depends on all the systems
+     * previously attached with which it conflicts and it will run only after
+     * all of them have returned.<br/>
+     * The signature of the function call operator should be equivalent to the
+     * following:
+     *
+     * @code{.cpp}
+     * void(Delta delta);
+     * @endcode
+     *
+     * @warning
+     * Attaching a system during an update results in undefined behavior.
+     *
+     * @tparam Access List of `Read` and `Write` tag types.
+     * @tparam Func Type of system to attach.
+     * @param func Either a lambda or a functor to use as a system.
+     */
+    template<typename... Access, typename Func>
+    void attach(Func &&func) {
+        using accumulator_type = int[];
+        System system{std::forward<Func>(func), {}, {}, {}, 0};
+        accumulator_type accumulator = { 0, (declare(system, Access{}), 0)... };
+        (void)accumulator;
+
+        for(auto &&other: systems) {
+            if(conflict(other, system)) {
+                other.next.push_back(systems.size());
+                ++system.prev;
+            }
+        }
+
+        systems.push_back(std::move(system));
+    }
+
+    /**
+     * @brief Runs all the systems attached to the graph.
+     *
+     * This function is blocking and it doesn't return until all the systems
+     * have been executed once. The thread that invokes it takes part in the
+     * execution of the systems.
+     *
+     * @param delta Elapsed time.
+     */
+    void update(Delta delta) {
+        std::unique_lock<std::mutex> lock{mutex};
+
+        this->delta = delta;
+        pending = systems.size();
+        counters.resize(systems.size());
+
+        for(size_type pos = 0; pos < systems.size(); ++pos) {
+            counters[pos] = systems[pos].prev;
+
+            if(!counters[pos]) {
+                ready.push_back(pos);
+            }
+        }
+
+        cv.notify_all();
+
+        while(pending) {
+            if(ready.empty()) {
+                cv.wait(lock);
+            } else {
+                run(lock);
+            }
+        }
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::vector<System> systems;
+    std::vector<size_type> counters;
+    std::vector<size_type> ready;
+    std::mutex mutex;
+    std::condition_variable cv;
+    Delta delta;
+    size_type pending;
+    bool stop;
+};
+
+
+}
+
+
+#endif // ENTT_ENTITY_SYSTEM_GRAPH_HPP
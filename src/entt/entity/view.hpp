@@ -5,6 +5,7 @@
 #include <tuple>
 #include <utility>
 #include "sparse_set.hpp"
+#include "profile.hpp"
 
 
 namespace entt {
@@ -30,6 +31,12 @@ namespace entt {
  * In all the other cases, modify the pools of the given components somehow
  * invalidates all the iterators and using them results in undefined behavior.
  *
+ * @warning
+ * The tombstone deletion policy doesn't apply to persistent views. The set of
+ * entities of a persistent view always uses the swap-and-pop policy, therefore
+ * removing components from entities other than the one currently pointed
+ * during an iteration isn't allowed, whatever the policy of the pools.
+ *
  * @note
  * Views share references to the underlying data structures with the Registry
  * that generated them. Therefore any change to the entities and to the
@@ -90,6 +97,15 @@ public:
         return view.size();
     }
 
+    /**
+     * @brief Returns the memory statistics of the set of entities shared
+     * between the persistent views with the same components.
+     * @return The memory statistics of the set of entities.
+     */
+    SparseSetStats stats() const noexcept {
+        return view.stats();
+    }
+
     /**
      * @brief Direct access to the list of entities.
      *
@@ -204,6 +220,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) {
+        ENTT_PROFILE(EACH, PersistentView);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get<Component>(entity)...);
         }
@@ -226,6 +243,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) const {
+        ENTT_PROFILE(EACH, PersistentView);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get<Component>(entity)...);
         }
@@ -473,6 +491,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) {
+        ENTT_PROFILE(EACH, View);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get<First>(entity), get<Other>(entity)...);
         }
@@ -495,6 +514,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) const {
+        ENTT_PROFILE(EACH, View);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get<First>(entity), get<Other>(entity)...);
         }
@@ -513,7 +533,7 @@ public:
     void reset() {
         using accumulator_type = void *[];
         view = &std::get<pool_type<First> &>(pools);
-        accumulator_type accumulator = { (std::get<pool_type<Other> &>(pools).size() < view->size() ? (view = &std::get<pool_type<Other> &>(pools)) : nullptr)... };
+        accumulator_type accumulator = { (std::get<pool_type<Other> &>(pools).length() < view->length() ? (view = &std::get<pool_type<Other> &>(pools)) : nullptr)... };
         (void)accumulator;
     }
 
@@ -589,10 +609,22 @@ public:
         return pool.size();
     }
 
+    /**
+     * @brief Returns the length of the underlying arrays.
+     *
+     * The length is the number of entities that have the given component plus
+     * the number of tombstones left behind by removed entities, if any.
+     *
+     * @return Length of the arrays returned by `raw` and `data`.
+     */
+    size_type length() const noexcept {
+        return pool.length();
+    }
+
     /**
      * @brief Direct access to the list of components.
      *
-     * The returned pointer is such that range `[raw(), raw() + size()]` is
+     * The returned pointer is such that range `[raw(), raw() + length()]` is
      * always a valid range, even if the container is empty.
      *
      * @note
@@ -608,7 +640,7 @@ public:
     /**
      * @brief Direct access to the list of components.
      *
-     * The returned pointer is such that range `[raw(), raw() + size()]` is
+     * The returned pointer is such that range `[raw(), raw() + length()]` is
      * always a valid range, even if the container is empty.
      *
      * @note
@@ -624,7 +656,7 @@ public:
     /**
      * @brief Direct access to the list of entities.
      *
-     * The returned pointer is such that range `[data(), data() + size()]` is
+     * The returned pointer is such that range `[data(), data() + length()]` is
      * always a valid range, even if the container is empty.
      *
      * @note
@@ -728,6 +760,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) {
+        ENTT_PROFILE(EACH, View);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get(entity));
         }
@@ -749,6 +782,7 @@ public:
      */
     template<typename Func>
     void each(Func &&func) const {
+        ENTT_PROFILE(EACH, View);
         for(auto entity: *this) {
             std::forward<Func>(func)(entity, get(entity));
         }
@@ -1,8 +1,16 @@
 #include "core/family.hpp"
 #include "core/hashed_string.hpp"
 #include "core/ident.hpp"
+#include "core/type_hash.hpp"
+#include "entity/entity_storage.hpp"
+#include "entity/hierarchy.hpp"
+#include "entity/profile.hpp"
+#include "entity/profiler.hpp"
 #include "entity/registry.hpp"
 #include "entity/sparse_set.hpp"
+#include "entity/spatial_grid.hpp"
+#include "entity/static_registry.hpp"
+#include "entity/system_graph.hpp"
 #include "entity/traits.hpp"
 #include "entity/view.hpp"
 #include "locator/locator.hpp"
@@ -5,9 +5,12 @@
 #include <vector>
 #include <memory>
 #include <utility>
+#include <cstddef>
 #include <cstdint>
-#include "../core/family.hpp"
+#include <type_traits>
+#include "../core/type_hash.hpp"
 #include "signal.hpp"
+#include "queue.hpp"
 #include "sigh.hpp"
 
 
@@ -22,30 +25,63 @@ namespace entt {
  * Listeners are provided in the form of member functions. For each event of
  * type `Event`, listeners must have the following signature:
  * `void(const Event &)`. Member functions named `receive` are automatically
- * detected and registered or unregistered by the dispatcher.
+ * detected and registered or unregistered by the dispatcher.<br/>
+ * Listeners can also receive events in batches. In this case, they must have
+ * the following signature: `void(const Event *, std::size_t)` and receive all
+ * the pending events of the given type at once, as a contiguous array.
+ *
+ * Pending events are stored in queues, one for each type of event. Events
+ * enqueued while the dispatcher is delivering the pending ones are delivered
+ * with the next update.
  *
  * @tparam Sig Type of the signal handler to use.
+ * @tparam Queue Type of queue to use for the pending events.
  */
-template<template<typename...> class Sig>
+template<template<typename...> class Sig, template<typename> class Queue = EventQueue>
 class Dispatcher final {
-    using event_family = Family<struct InternalDispatcherEventFamily>;
-
     template<typename Class, typename Event>
     using instance_type = typename Sig<void(const Event &)>::template instance_type<Class>;
 
     struct BaseSignalWrapper {
         virtual ~BaseSignalWrapper() = default;
-        virtual void publish(std::size_t) = 0;
+        virtual void flip() = 0;
+        virtual void publish() = 0;
     };
 
     template<typename Event>
-    struct SignalWrapper final: BaseSignalWrapper {
-        void publish(std::size_t current) final override {
-            for(auto &&event: events[current]) {
-                signal.publish(event);
+    static void deliver(Signal<void(const Event &)> &signal, const std::vector<Event> &events) {
+        if(!events.empty()) {
+            // instances are pinned once for all the pending events
+            const auto batch = signal.batch();
+
+            for(auto &&event: events) {
+                batch.publish(event);
             }
+        }
+    }
 
-            events[current].clear();
+    template<typename Other, typename Event>
+    static void deliver(Other &signal, const std::vector<Event> &events) {
+        for(auto &&event: events) {
+            signal.publish(event);
+        }
+    }
+
+    template<typename Event>
+    struct SignalWrapper final: BaseSignalWrapper {
+        void flip() final override {
+            queue.flip(events);
+        }
+
+        void publish() final override {
+            if(!events.empty()) {
+                if(!signal.empty()) {
+                    deliver(signal, events);
+                }
+
+                batches.publish(events.data(), events.size());
+                events.clear();
+            }
         }
 
         template<typename Class, void(Class::*Member)(const Event &)>
@@ -58,34 +94,44 @@ class Dispatcher final {
             signal.template disconnect<Class, Member>(std::move(instance));
         }
 
+        template<typename Class, void(Class::*Member)(const Event *, std::size_t)>
+        inline void connect_batch(instance_type<Class, Event> instance) noexcept {
+            batches.template connect<Class, Member>(std::move(instance));
+        }
+
+        template<typename Class, void(Class::*Member)(const Event *, std::size_t)>
+        inline void disconnect_batch(instance_type<Class, Event> instance) noexcept {
+            batches.template disconnect<Class, Member>(std::move(instance));
+        }
+
         template<typename... Args>
         inline void trigger(Args&&... args) {
-            signal.publish({ std::forward<Args>(args)... });
+            const Event event{ std::forward<Args>(args)... };
+            signal.publish(event);
+            batches.publish(&event, 1);
         }
 
         template<typename... Args>
-        inline void enqueue(std::size_t current, Args&&... args) {
-            events[current].push_back({ std::forward<Args>(args)... });
+        inline void enqueue(Args&&... args) {
+            queue.push(std::forward<Args>(args)...);
         }
 
     private:
         Sig<void(const Event &)> signal{};
-        std::vector<Event> events[2];
+        Sig<void(const Event *, std::size_t)> batches{};
+        Queue<Event> queue{};
+        std::vector<Event> events{};
     };
 
-    inline static std::size_t buffer(bool mode) {
-        return mode ? 0 : 1;
-    }
-
     template<typename Event>
     SignalWrapper<Event> & wrapper() {
-        auto type = event_family::type<Event>();
+        constexpr auto hash = TypeHash<std::decay_t<Event>>::value();
+        auto type = types.find(hash);
 
-        if(!(type < wrappers.size())) {
+        // known types are looked up without modifying the dispatcher
+        if(type == HashIndex::null) {
+            type = types.insert(hash);
             wrappers.resize(type + 1);
-        }
-
-        if(!wrappers[type]) {
             wrappers[type] = std::make_unique<SignalWrapper<Event>>();
         }
 
@@ -95,7 +141,7 @@ class Dispatcher final {
 public:
     /*! @brief Default constructor. */
     Dispatcher() noexcept
-        : wrappers{}, mode{false}
+        : types{}, wrappers{}
     {}
 
     /**
@@ -140,6 +186,51 @@ public:
         wrapper<Event>().template disconnect<Class, Member>(std::move(instance));
     }
 
+    /**
+     * @brief Registers a listener that receives events in batches.
+     *
+     * A matching member function has the following signature:
+     * `void receive(const Event *, std::size_t)`. Member functions named
+     * `receive` are automatically detected and registered if available.<br/>
+     * Pending events are delivered to listeners of this type once per update,
+     * after the ones that receive events one at a time. Immediate events are
+     * delivered as batches of a single event.
+     *
+     * @warning
+     * Connecting a listener during an update may lead to unexpected behavior.
+     * Register listeners before or after invoking the update if possible.
+     *
+     * @tparam Event Type of event to which to connect the function.
+     * @tparam Class Type of class to which the member function belongs.
+     * @tparam Member Member function to connect to the signal.
+     * @param instance A valid instance of the right type.
+     */
+    template<typename Event, typename Class, void(Class::*Member)(const Event *, std::size_t) = &Class::receive>
+    void connect_batch(instance_type<Class, Event> instance) noexcept {
+        wrapper<Event>().template connect_batch<Class, Member>(std::move(instance));
+    }
+
+    /**
+     * @brief Unregisters a listener that receives events in batches.
+     *
+     * A matching member function has the following signature:
+     * `void receive(const Event *, std::size_t)`. Member functions named
+     * `receive` are automatically detected and unregistered if available.
+     *
+     * @warning
+     * Disonnecting a listener during an update may lead to unexpected behavior.
+     * Unregister listeners before or after invoking the update if possible.
+     *
+     * @tparam Event Type of event from which to disconnect the function.
+     * @tparam Class Type of class to which the member function belongs.
+     * @tparam Member Member function to connect to the signal.
+     * @param instance A valid instance of the right type.
+     */
+    template<typename Event, typename Class, void(Class::*Member)(const Event *, std::size_t) = &Class::receive>
+    void disconnect_batch(instance_type<Class, Event> instance) noexcept {
+        wrapper<Event>().template disconnect_batch<Class, Member>(std::move(instance));
+    }
+
     /**
      * @brief Triggers an immediate event of the given type.
      *
@@ -167,7 +258,7 @@ public:
      */
     template<typename Event, typename... Args>
     void enqueue(Args&&... args) {
-        wrapper<Event>().enqueue(buffer(mode), std::forward<Args>(args)...);
+        wrapper<Event>().enqueue(std::forward<Args>(args)...);
     }
 
     /**
@@ -178,19 +269,19 @@ public:
      * to reduce at a minimum the time spent in the bodies of the listeners.
      */
     void update() {
-        auto buf = buffer(mode);
-        mode = !mode;
+        // pending events are collected first, new ones wait for the next update
+        for(auto &&wrapper: wrappers) {
+            wrapper->flip();
+        }
 
         for(auto &&wrapper: wrappers) {
-            if(wrapper) {
-                wrapper->publish(buf);
-            }
+            wrapper->publish();
         }
     }
 
 private:
+    HashIndex types;
     std::vector<std::unique_ptr<BaseSignalWrapper>> wrappers;
-    bool mode;
 };
 
 
@@ -216,6 +307,40 @@ using ManagedDispatcher = Dispatcher<Signal>;
 using UnmanagedDispatcher = Dispatcher<SigH>;
 
 
+/**
+ * @brief Managed concurrent dispatcher.
+ *
+ * A managed dispatcher the queues of which are multi-producer, single-consumer
+ * queues. Events can be enqueued concurrently from multiple threads, while the
+ * update is meant to be invoked by a single thread, even while the producers
+ * are running.
+ *
+ * @warning
+ * Only enqueuing events is thread safe. Moreover, the types of events must be
+ * already known to the dispatcher before the producers start, that is, either
+ * a listener was connected or an event was triggered or enqueued for each
+ * type.
+ */
+using ManagedConcurrentDispatcher = Dispatcher<Signal, ConcurrentEventQueue>;
+
+
+/**
+ * @brief Unmanaged concurrent dispatcher.
+ *
+ * An unmanaged dispatcher the queues of which are multi-producer,
+ * single-consumer queues. Events can be enqueued concurrently from multiple
+ * threads, while the update is meant to be invoked by a single thread, even
+ * while the producers are running.
+ *
+ * @warning
+ * Only enqueuing events is thread safe. Moreover, the types of events must be
+ * already known to the dispatcher before the producers start, that is, either
+ * a listener was connected or an event was triggered or enqueued for each
+ * type.
+ */
+using UnmanagedConcurrentDispatcher = Dispatcher<SigH, ConcurrentEventQueue>;
+
+
 }
 
 
@@ -10,6 +10,7 @@
 #include <memory>
 #include <vector>
 #include <list>
+#include "../core/type_hash.hpp"
 
 
 namespace entt {
@@ -111,20 +112,9 @@ class Emitter {
         container_type onL{};
     };
 
-    static std::size_t next() noexcept {
-        static std::size_t counter = 0;
-        return counter++;
-    }
-
-    template<typename>
-    static std::size_t type() noexcept {
-        static std::size_t value = next();
-        return value;
-    }
-
     template<typename Event>
     Handler<Event> & handler() noexcept {
-        std::size_t family = type<Event>();
+        const auto family = types.insert(TypeHash<Event>::value());
 
         if(!(family < handlers.size())) {
             handlers.resize(family+1);
@@ -314,7 +304,7 @@ public:
      */
     template<typename Event>
     bool empty() const noexcept {
-        std::size_t family = type<Event>();
+        const auto family = types.find(TypeHash<Event>::value());
 
         return (!(family < handlers.size()) ||
                 !handlers[family] ||
@@ -331,6 +321,7 @@ public:
     }
 
 private:
+    HashIndex types{};
     std::vector<std::unique_ptr<BaseHandler>> handlers{};
 };
 
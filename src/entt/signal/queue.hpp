@@ -0,0 +1,170 @@
+#ifndef ENTT_SIGNAL_QUEUE_HPP
+#define ENTT_SIGNAL_QUEUE_HPP
+
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+
+namespace entt {
+
+
+/**
+ * @brief Queue of pending events.
+ *
+ * Default queue of the dispatcher. Events are stored in a vector that is
+ * swapped with the one of the consumer when events are delivered, so that the
+ * memory is reused from tick to tick.
+ *
+ * @warning
+ * The queue isn't thread safe. Use a concurrent queue if events are enqueued
+ * from multiple threads.
+ *
+ * @tparam Event Type of events.
+ */
+template<typename Event>
+class EventQueue final {
+public:
+    /**
+     * @brief Enqueues an event.
+     * @tparam Args Types of arguments to use to construct the event.
+     * @param args Arguments to use to construct the event.
+     */
+    template<typename... Args>
+    void push(Args&&... args) {
+        events.push_back({ std::forward<Args>(args)... });
+    }
+
+    /**
+     * @brief Moves all the pending events at the end of the given vector.
+     * @param other The vector to fill with the pending events.
+     */
+    void flip(std::vector<Event> &other) {
+        if(other.empty()) {
+            using std::swap;
+            swap(events, other);
+        } else {
+            other.insert(other.end(), std::make_move_iterator(events.begin()), std::make_move_iterator(events.end()));
+            events.clear();
+        }
+    }
+
+private:
+    std::vector<Event> events{};
+};
+
+
+/**
+ * @brief Multi-producer, single-consumer queue of pending events.
+ *
+ * Queue that can be filled from multiple threads at once. Each producer is
+ * assigned one of a fixed number of slots the first time it pushes an event
+ * and appends its events to the vector of the slot. A slot is guarded by an
+ * atomic flag that is contended only by the consumer while it collects the
+ * events or by producers that share the slot, when there are more producers
+ * than slots.<br/>
+ * Events pushed by the same thread are delivered in the same order in which
+ * they were pushed. There are no guarantees on the order of events pushed by
+ * different threads.
+ *
+ * @tparam Event Type of events.
+ */
+template<typename Event>
+class ConcurrentEventQueue final {
+    static constexpr std::size_t slots = 16;
+
+    struct Slot final {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        std::vector<Event> events{};
+        // keeps slots used by different threads on different cache lines
+        char padding[64];
+    };
+
+    struct Guard final {
+        Guard(std::atomic_flag &flag) noexcept
+            : flag{flag}
+        {
+            while(flag.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        ~Guard() {
+            flag.clear(std::memory_order_release);
+        }
+
+        std::atomic_flag &flag;
+    };
+
+    static std::size_t slot() noexcept {
+        static std::atomic<std::size_t> next{0};
+        static thread_local const std::size_t current = next++ % slots;
+        return current;
+    }
+
+public:
+    /*! @brief Default constructor. */
+    ConcurrentEventQueue() noexcept = default;
+
+    /*! @brief Copying a queue isn't allowed. */
+    ConcurrentEventQueue(const ConcurrentEventQueue &) = delete;
+    /*! @brief Moving a queue isn't allowed. */
+    ConcurrentEventQueue(ConcurrentEventQueue &&) = delete;
+
+    /**
+     * @brief Copying a queue isn't allowed.
+     * @return This queue.
+     */
+    ConcurrentEventQueue & operator=(const ConcurrentEventQueue &) = delete;
+
+    /**
+     * @brief Moving a queue isn't allowed.
+     * @return This queue.
+     */
+    ConcurrentEventQueue & operator=(ConcurrentEventQueue &&) = delete;
+
+    /**
+     * @brief Enqueues an event.
+     *
+     * This function can be invoked concurrently from multiple threads, as well
+     * as while the consumer is flipping the queue.
+     *
+     * @tparam Args Types of arguments to use to construct the event.
+     * @param args Arguments to use to construct the event.
+     */
+    template<typename... Args>
+    void push(Args&&... args) {
+        auto &curr = queues[slot()];
+        Guard guard{curr.busy};
+        curr.events.push_back({ std::forward<Args>(args)... });
+    }
+
+    /**
+     * @brief Moves all the pending events at the end of the given vector.
+     *
+     * Only the consumer is allowed to invoke this function. Events pushed in
+     * the meantime are either collected or left to the next call.
+     *
+     * @param other The vector to fill with the pending events.
+     */
+    void flip(std::vector<Event> &other) {
+        for(auto &&curr: queues) {
+            Guard guard{curr.busy};
+            other.insert(other.end(), std::make_move_iterator(curr.events.begin()), std::make_move_iterator(curr.events.end()));
+            curr.events.clear();
+        }
+    }
+
+private:
+    Slot queues[slots];
+};
+
+
+}
+
+
+#endif // ENTT_SIGNAL_QUEUE_HPP
@@ -2,9 +2,16 @@
 #define ENTT_SIGNAL_SIGH_HPP
 
 
+#include <type_traits>
 #include <algorithm>
 #include <utility>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+#ifndef ENTT_SIGH_INLINE_SIZE
+#define ENTT_SIGH_INLINE_SIZE 2
+#endif
 
 
 namespace entt {
@@ -13,6 +20,137 @@ namespace entt {
 namespace {
 
 
+template<typename Type, std::size_t Size>
+class SmallBuffer final {
+    static_assert(Size > 0, "!");
+    static_assert(std::is_trivial<Type>::value, "!");
+
+    void release() noexcept {
+        if(capacity != Size) {
+            delete[] storage.heap;
+            storage.heap = nullptr;
+            capacity = Size;
+        }
+    }
+
+    void steal(SmallBuffer &other) noexcept {
+        storage = other.storage;
+        count = other.count;
+        capacity = other.capacity;
+        other.capacity = Size;
+        other.count = 0;
+    }
+
+public:
+    using size_type = std::size_t;
+    using iterator_type = Type *;
+    using const_iterator_type = const Type *;
+
+    SmallBuffer() noexcept = default;
+
+    SmallBuffer(const SmallBuffer &other)
+        : SmallBuffer{}
+    {
+        for(auto &&value: other) {
+            push_back(value);
+        }
+    }
+
+    SmallBuffer(SmallBuffer &&other) noexcept
+        : SmallBuffer{}
+    {
+        steal(other);
+    }
+
+    ~SmallBuffer() {
+        release();
+    }
+
+    SmallBuffer & operator=(const SmallBuffer &other) {
+        if(this != &other) {
+            SmallBuffer copy{other};
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    SmallBuffer & operator=(SmallBuffer &&other) noexcept {
+        if(this != &other) {
+            release();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    size_type size() const noexcept {
+        return count;
+    }
+
+    bool empty() const noexcept {
+        return !count;
+    }
+
+    void clear() noexcept {
+        release();
+        count = 0;
+    }
+
+    void push_back(const Type &value) {
+        if(count == capacity) {
+            // spills to the heap once the inline storage is full
+            const std::uint32_t next = 2 * capacity;
+            auto *data = new Type[next];
+            std::copy(begin(), end(), data);
+            release();
+            storage.heap = data;
+            capacity = next;
+        }
+
+        begin()[count++] = value;
+    }
+
+    void pop_back() noexcept {
+        --count;
+    }
+
+    iterator_type begin() noexcept {
+        return capacity == Size ? storage.local : storage.heap;
+    }
+
+    iterator_type end() noexcept {
+        return begin() + count;
+    }
+
+    const_iterator_type begin() const noexcept {
+        return capacity == Size ? storage.local : storage.heap;
+    }
+
+    const_iterator_type end() const noexcept {
+        return begin() + count;
+    }
+
+    const_iterator_type cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator_type cend() const noexcept {
+        return end();
+    }
+
+private:
+    union Storage {
+        Type local[Size];
+        Type *heap;
+    } storage;
+
+    // narrow counters keep signals with inline listeners as small as possible
+    std::uint32_t count{};
+    std::uint32_t capacity{Size};
+};
+
+
 template<typename, typename>
 struct Invoker;
 
@@ -20,9 +158,15 @@ struct Invoker;
 template<typename Ret, typename... Args, typename Collector>
 struct Invoker<Ret(Args...), Collector> {
     using proto_type = Ret(*)(void *, Args...);
-    using call_type = std::pair<void *, proto_type>;
 
-    virtual ~Invoker() = default;
+    struct call_type {
+        void *instance;
+        proto_type proto;
+
+        bool operator==(const call_type &other) const noexcept {
+            return instance == other.instance && proto == other.proto;
+        }
+    };
 
     template<typename SFINAE = Ret>
     typename std::enable_if<std::is_void<SFINAE>::value, bool>::type
@@ -95,6 +239,10 @@ class SigH;
  * * Creating signals used later to notify a bunch of listeners.
  * * Collecting results from a set of functions like in a voting system.
  *
+ * Up to `ENTT_SIGH_INLINE_SIZE` listeners (two by default) are stored within
+ * the signal itself and don't require dynamic allocations. Define the macro
+ * before to include the header to change the number of inline listeners.
+ *
  * The default collector does nothing. To properly collect data, define and use
  * a class that has a call operator the signature of which is `bool(Param)` and:
  *
@@ -120,9 +268,15 @@ class SigH<Ret(Args...), Collector> final: private Invoker<Ret(Args...), Collect
         return (static_cast<Class *>(instance)->*Member)(args...);
     }
 
+    struct slot_type {
+        call_type call;
+        // unique per connection, it tells apart listeners that reuse a slot
+        std::uint32_t stamp;
+    };
+
 public:
     /*! @brief Unsigned integer type. */
-    using size_type = typename std::vector<call_type>::size_type;
+    using size_type = std::size_t;
     /*! @brief Collector type. */
     using collector_type = Collector;
 
@@ -133,12 +287,127 @@ public:
     template<typename Class>
     using instance_type = Class *;
 
+    /**
+     * @brief Opaque handle to a listener connected to a signal.
+     *
+     * Connections are returned by the signal when listeners are connected and
+     * can be used later to disconnect them in constant time. A connection that
+     * refers to a listener already disconnected is harmless, even if its slot
+     * has been reused in the meantime.
+     */
+    class Connection final {
+        /*! @brief Signal handlers are friend classes of connections. */
+        friend class SigH;
+
+        Connection(size_type index, std::uint32_t stamp) noexcept
+            : index{index}, stamp{stamp}
+        {}
+
+    public:
+        /*! @brief Default constructor, the connection refers to no listener. */
+        Connection() noexcept
+            : index{~size_type{}}, stamp{}
+        {}
+
+    private:
+        size_type index;
+        std::uint32_t stamp;
+    };
+
+private:
+    Connection attach(call_type call) {
+        const auto last = calls.size();
+        auto hole = last;
+
+        // listeners are never moved, free slots are reused in order
+        for(size_type pos = 0; pos < last; ++pos) {
+            const auto &curr = calls.cbegin()[pos];
+
+            if(curr.call == call) {
+                return Connection{pos, curr.stamp};
+            } else if(!curr.call.proto && hole == last) {
+                hole = pos;
+            }
+        }
+
+        // stamps are never reset, not even by clear, zero is never used
+        const slot_type slot{call, ++counter};
+
+        if(hole == last) {
+            calls.push_back(slot);
+        } else {
+            calls.begin()[hole] = slot;
+            --dead;
+        }
+
+        return Connection{hole, slot.stamp};
+    }
+
+    void detach(size_type pos) noexcept {
+        calls.begin()[pos].call = call_type{nullptr, nullptr};
+        ++dead;
+
+        // trailing free slots are released so as not to visit them on publish
+        while(!calls.empty() && !calls.cend()[-1].call.proto) {
+            calls.pop_back();
+            --dead;
+        }
+    }
+
+    void detach(call_type target) noexcept {
+        for(size_type pos = 0, last = calls.size(); pos < last; ++pos) {
+            if(calls.cbegin()[pos].call == target) {
+                detach(pos);
+                break;
+            }
+        }
+    }
+
+public:
+    /*! @brief Default constructor. */
+    SigH() noexcept = default;
+
+    /*! @brief Default copy constructor. */
+    SigH(const SigH &) = default;
+
+    /**
+     * @brief Move constructor.
+     * @param other The instance to move from.
+     */
+    SigH(SigH &&other) noexcept
+        : calls{std::move(other.calls)}, dead{other.dead}, counter{other.counter}
+    {
+        other.dead = 0;
+    }
+
+    /**
+     * @brief Default copy assignment operator.
+     * @return This signal.
+     */
+    SigH & operator=(const SigH &) = default;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other The instance to move from.
+     * @return This signal.
+     */
+    SigH & operator=(SigH &&other) noexcept {
+        if(this != &other) {
+            calls = std::move(other.calls);
+            dead = other.dead;
+            counter = other.counter;
+            other.dead = 0;
+        }
+
+        return *this;
+    }
+
     /**
      * @brief Number of listeners connected to the signal.
      * @return Number of listeners currently connected.
      */
     size_type size() const noexcept {
-        return calls.size();
+        return calls.size() - dead;
     }
 
     /**
@@ -146,28 +415,32 @@ public:
      * @return True if the signal has no listeners connected, false otherwise.
      */
     bool empty() const noexcept {
-        return calls.empty();
+        return !size();
     }
 
     /**
      * @brief Disconnects all the listeners from a signal.
+     *
+     * The storage is released. Connections to the listeners just disconnected
+     * don't refer to the listeners connected later, if any.
      */
     void clear() noexcept {
         calls.clear();
+        dead = 0;
     }
 
     /**
      * @brief Connects a free function to a signal.
      *
      * The signal handler performs checks to avoid multiple connections for free
-     * functions.
+     * functions. Connecting a function twice returns the same connection.
      *
      * @tparam Function A valid free function pointer.
+     * @return A connection object that can be used to disconnect the function.
      */
     template<Ret(*Function)(Args...)>
-    void connect() {
-        disconnect<Function>();
-        calls.emplace_back(nullptr, &proto<Function>);
+    Connection connect() {
+        return attach(call_type{nullptr, &proto<Function>});
     }
 
     /**
@@ -177,15 +450,16 @@ public:
      * guarantee that the lifetime of the instance overcomes the one of the
      * signal. On the other side, the signal handler performs checks to avoid
      * multiple connections for the same member function of a given instance.
+     * Connecting a listener twice returns the same connection.
      *
      * @tparam Class Type of class to which the member function belongs.
      * @tparam Member Member function to connect to the signal.
      * @param instance A valid instance of type pointer to `Class`.
+     * @return A connection object that can be used to disconnect the listener.
      */
     template <typename Class, Ret(Class::*Member)(Args...)>
-    void connect(instance_type<Class> instance) {
-        disconnect<Class, Member>(instance);
-        calls.emplace_back(instance, &proto<Class, Member>);
+    Connection connect(instance_type<Class> instance) {
+        return attach(call_type{instance, &proto<Class, Member>});
     }
 
     /**
@@ -194,8 +468,7 @@ public:
      */
     template<Ret(*Function)(Args...)>
     void disconnect() {
-        call_type target{nullptr, &proto<Function>};
-        calls.erase(std::remove(calls.begin(), calls.end(), std::move(target)), calls.end());
+        detach(call_type{nullptr, &proto<Function>});
     }
 
     /**
@@ -206,8 +479,7 @@ public:
      */
     template<typename Class, Ret(Class::*Member)(Args...)>
     void disconnect(instance_type<Class> instance) {
-        call_type target{instance, &proto<Class, Member>};
-        calls.erase(std::remove(calls.begin(), calls.end(), std::move(target)), calls.end());
+        detach(call_type{instance, &proto<Class, Member>});
     }
 
     /**
@@ -217,8 +489,31 @@ public:
      */
     template<typename Class>
     void disconnect(instance_type<Class> instance) {
-        auto func = [instance](const call_type &call) { return call.first == instance; };
-        calls.erase(std::remove_if(calls.begin(), calls.end(), std::move(func)), calls.end());
+        for(size_type pos = 0; pos < calls.size(); ++pos) {
+            const auto &curr = calls.cbegin()[pos].call;
+
+            if(curr.proto && curr.instance == instance) {
+                detach(pos);
+            }
+        }
+    }
+
+    /**
+     * @brief Disconnects a listener by means of its connection in constant
+     * time.
+     *
+     * Connections that refer to listeners already disconnected are ignored.
+     *
+     * @param conn A connection object returned by the signal.
+     */
+    void disconnect(const Connection &conn) noexcept {
+        if(conn.index < calls.size()) {
+            const auto &slot = calls.cbegin()[conn.index];
+
+            if(slot.call.proto && slot.stamp == conn.stamp) {
+                detach(conn.index);
+            }
+        }
     }
 
     /**
@@ -229,8 +524,10 @@ public:
      * @param args Arguments to use to invoke listeners.
      */
     void publish(Args... args) {
-        for(auto &&call: calls) {
-            call.second(call.first, args...);
+        for(auto &&slot: calls) {
+            if(slot.call.proto) {
+                slot.call.proto(slot.call.instance, args...);
+            }
         }
     }
 
@@ -242,8 +539,8 @@ public:
     collector_type collect(Args... args) {
         collector_type collector;
 
-        for(auto &&call: calls) {
-            if(!this->invoke(collector, call.second, call.first, args...)) {
+        for(auto &&slot: calls) {
+            if(slot.call.proto && !this->invoke(collector, slot.call.proto, slot.call.instance, args...)) {
                 break;
             }
         }
@@ -259,23 +556,46 @@ public:
     friend void swap(SigH &lhs, SigH &rhs) {
         using std::swap;
         swap(lhs.calls, rhs.calls);
+        swap(lhs.dead, rhs.dead);
+        swap(lhs.counter, rhs.counter);
     }
 
     /**
      * @brief Checks if the contents of the two signals are identical.
      *
      * Two signals are identical if they have the same size and the same
-     * listeners registered exactly in the same order.
+     * listeners stored exactly in the same order.<br/>
+     * Slots of disconnected listeners are reused, therefore the order in which
+     * listeners are stored can differ from the order in which they were
+     * connected.
      *
      * @param other Signal with which to compare.
      * @return True if the two signals are identical, false otherwise.
      */
     bool operator==(const SigH &other) const noexcept {
-        return std::equal(calls.cbegin(), calls.cend(), other.calls.cbegin(), other.calls.cend());
+        auto lhs = calls.cbegin();
+        auto rhs = other.calls.cbegin();
+        bool equal = true;
+
+        // free slots don't take part in the comparison
+        while(equal) {
+            for(; lhs != calls.cend() && !lhs->call.proto; ++lhs);
+            for(; rhs != other.calls.cend() && !rhs->call.proto; ++rhs);
+
+            if(lhs == calls.cend() || rhs == other.calls.cend()) {
+                break;
+            }
+
+            equal = ((lhs++)->call == (rhs++)->call);
+        }
+
+        return equal && lhs == calls.cend() && rhs == other.calls.cend();
     }
 
 private:
-    std::vector<call_type> calls;
+    SmallBuffer<slot_type, ENTT_SIGH_INLINE_SIZE> calls;
+    size_type dead{};
+    std::uint32_t counter{};
 };
 
 
@@ -283,7 +603,7 @@ private:
  * @brief Checks if the contents of the two signals are different.
  *
  * Two signals are identical if they have the same size and the same
- * listeners registered exactly in the same order.
+ * listeners stored exactly in the same order.
  *
  * @tparam Ret Return type of a function type.
  * @tparam Args Types of arguments of a function type.
@@ -5,9 +5,9 @@
 #include <memory>
 #include <vector>
 #include <utility>
+#include <cstddef>
 #include <cstdint>
-#include <iterator>
-#include <algorithm>
+#include <cassert>
 
 
 namespace entt {
@@ -37,26 +37,39 @@ class Signal;
  */
 template<typename... Args>
 class Signal<void(Args...)> final {
-    using proto_type = bool(*)(std::weak_ptr<void> &, Args...);
-    using call_type = std::pair<std::weak_ptr<void>, proto_type>;
+    using proto_type = void(*)(void *, Args...);
+
+    struct call_type {
+        std::weak_ptr<void> instance;
+        // aliasing pointers share the owner, the pointee tells them apart
+        void *target;
+        proto_type proto;
+    };
+
+    struct slot_type {
+        call_type call;
+        // unique per connection, it tells apart listeners that reuse a slot
+        std::uint32_t stamp;
+    };
 
     template<void(*Function)(Args...)>
-    static bool proto(std::weak_ptr<void> &, Args... args) {
+    static void proto(void *, Args... args) {
         Function(args...);
-        return true;
     }
 
     template<typename Class, void(Class::*Member)(Args...)>
-    static bool proto(std::weak_ptr<void> &wptr, Args... args) {
-        bool ret = false;
+    static void proto(void *instance, Args... args) {
+        (static_cast<Class *>(instance)->*Member)(args...);
+    }
 
-        if(!wptr.expired()) {
-            auto ptr = std::static_pointer_cast<Class>(wptr.lock());
-            (ptr.get()->*Member)(args...);
-            ret = true;
-        }
+    // compares the control blocks and the pointees, it doesn't lock the pointers
+    static bool same(const call_type &call, const std::weak_ptr<void> &instance, const void *target) noexcept {
+        return call.target == target && !call.instance.owner_before(instance) && !instance.owner_before(call.instance);
+    }
 
-        return ret;
+    // free functions aren't bound to any instance, empty instances are rejected
+    static bool unbound(const call_type &call) noexcept {
+        return !call.target;
     }
 
 public:
@@ -70,12 +83,186 @@ public:
     template<typename Class>
     using instance_type = std::shared_ptr<Class>;
 
+    /**
+     * @brief Opaque handle to a listener connected to a signal.
+     *
+     * Connections are returned by the signal when listeners are connected and
+     * can be used later to disconnect them in constant time. A connection that
+     * refers to a listener already disconnected is harmless, even if its slot
+     * has been reused in the meantime.<br/>
+     * Connections don't keep alive the instances to which they refer.
+     */
+    class Connection final {
+        /*! @brief Signal handlers are friend classes of connections. */
+        friend class Signal;
+
+        Connection(size_type index, std::uint32_t stamp) noexcept
+            : index{index}, stamp{stamp}
+        {}
+
+    public:
+        /*! @brief Default constructor, the connection refers to no listener. */
+        Connection() noexcept
+            : index{~size_type{}}, stamp{}
+        {}
+
+    private:
+        size_type index;
+        std::uint32_t stamp;
+    };
+
+    /**
+     * @brief Snapshot of the listeners connected to a signal.
+     *
+     * A batch pins the instances of the listeners connected to a signal when
+     * it's created and keeps them alive until it's destroyed. Publishing events
+     * through a batch doesn't touch the reference counts of the instances, this
+     * makes it the best option to send many events at once.<br/>
+     * Listeners connected to or disconnected from the signal after the creation
+     * of a batch aren't visible to the batch.
+     */
+    class Batch final {
+        /*! @brief Signal handlers are friend classes of batches. */
+        friend class Signal;
+
+        Batch(Signal &signal)
+            : pinned{}, targets{}
+        {
+            targets.reserve(signal.size());
+
+            // detaching a listener can release trailing slots, size is read every time
+            for(size_type pos = 0; pos < signal.calls.size(); ++pos) {
+                const auto &call = signal.calls[pos].call;
+
+                if(call.proto) {
+                    if(unbound(call)) {
+                        targets.emplace_back(nullptr, call.proto);
+                    } else if(auto ptr = call.instance.lock()) {
+                        targets.emplace_back(ptr.get(), call.proto);
+                        pinned.push_back(std::move(ptr));
+                    } else {
+                        // expired listeners are released once and for all
+                        signal.detach(pos);
+                    }
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Triggers the signal for the listeners of the batch.
+         *
+         * All the listeners are notified. Order isn't guaranteed.
+         *
+         * @param args Arguments to use to invoke listeners.
+         */
+        void publish(Args... args) const {
+            for(auto &&target: targets) {
+                target.second(target.first, args...);
+            }
+        }
+
+    private:
+        std::vector<std::shared_ptr<void>> pinned;
+        std::vector<std::pair<void *, proto_type>> targets;
+    };
+
+private:
+    Connection attach(call_type call) {
+        const auto last = calls.size();
+        auto hole = last;
+
+        // listeners are never moved, free slots are reused in order
+        for(size_type pos = 0; pos < last; ++pos) {
+            const auto &curr = calls[pos];
+
+            if(curr.call.proto == call.proto && same(curr.call, call.instance, call.target)) {
+                return Connection{pos, curr.stamp};
+            } else if(!curr.call.proto && hole == last) {
+                hole = pos;
+            }
+        }
+
+        // stamps are never reset, not even by clear, zero is never used
+        const auto stamp = ++counter;
+
+        if(hole == last) {
+            calls.push_back(slot_type{std::move(call), stamp});
+        } else {
+            calls[hole] = slot_type{std::move(call), stamp};
+            --dead;
+        }
+
+        return Connection{hole, stamp};
+    }
+
+    void detach(size_type pos) noexcept {
+        calls[pos].call = call_type{{}, nullptr, nullptr};
+        ++dead;
+
+        // trailing free slots are released so as not to visit them on publish
+        while(!calls.empty() && !calls.back().call.proto) {
+            calls.pop_back();
+            --dead;
+        }
+    }
+
+    template<typename Func>
+    void detach(Func func) noexcept {
+        for(size_type pos = 0; pos < calls.size(); ++pos) {
+            if(calls[pos].call.proto && func(calls[pos].call)) {
+                detach(pos);
+            }
+        }
+    }
+
+public:
+    /*! @brief Default constructor. */
+    Signal() noexcept = default;
+
+    /*! @brief Default copy constructor. */
+    Signal(const Signal &) = default;
+
+    /**
+     * @brief Move constructor.
+     * @param other The instance to move from.
+     */
+    Signal(Signal &&other) noexcept
+        : calls{std::move(other.calls)}, dead{other.dead}, counter{other.counter}
+    {
+        other.calls.clear();
+        other.dead = 0;
+    }
+
+    /**
+     * @brief Default copy assignment operator.
+     * @return This signal.
+     */
+    Signal & operator=(const Signal &) = default;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other The instance to move from.
+     * @return This signal.
+     */
+    Signal & operator=(Signal &&other) noexcept {
+        if(this != &other) {
+            calls = std::move(other.calls);
+            dead = other.dead;
+            counter = other.counter;
+            other.calls.clear();
+            other.dead = 0;
+        }
+
+        return *this;
+    }
+
     /**
      * @brief Number of listeners connected to the signal.
      * @return Number of listeners currently connected.
      */
     size_type size() const noexcept {
-        return calls.size();
+        return calls.size() - dead;
     }
 
     /**
@@ -83,44 +270,57 @@ public:
      * @return True if the signal has no listeners connected, false otherwise.
      */
     bool empty() const noexcept {
-        return calls.empty();
+        return !size();
     }
 
     /**
      * @brief Disconnects all the listeners from a signal.
+     *
+     * The storage is released. Connections to the listeners just disconnected
+     * don't refer to the listeners connected later, if any.
      */
     void clear() noexcept {
-        calls.clear();
+        std::vector<slot_type>{}.swap(calls);
+        dead = 0;
     }
 
     /**
      * @brief Connects a free function to a signal.
      *
      * The signal handler performs checks to avoid multiple connections for free
-     * functions.
+     * functions. Connecting a function twice returns the same connection.
      *
      * @tparam Function A valid free function pointer.
+     * @return A connection object that can be used to disconnect the function.
      */
     template<void(*Function)(Args...)>
-    void connect() {
-        disconnect<Function>();
-        calls.emplace_back(std::weak_ptr<void>{}, &proto<Function>);
+    Connection connect() {
+        return attach(call_type{{}, nullptr, &proto<Function>});
     }
 
     /**
      * @brief Connects a member function for a given instance to a signal.
      *
      * The signal handler performs checks to avoid multiple connections for the
-     * same member function of a given instance.
+     * same member function of a given instance. Connecting a listener twice
+     * returns the same connection.
+     *
+     * @warning
+     * Attempting to connect an empty instance results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * empty instances.
      *
      * @tparam Class Type of class to which the member function belongs.
      * @tparam Member Member function to connect to the signal.
      * @param instance A valid instance of type pointer to `Class`.
+     * @return A connection object that can be used to disconnect the listener.
      */
     template<typename Class, void(Class::*Member)(Args...)>
-    void connect(instance_type<Class> instance) {
-        disconnect<Class, Member>(instance);
-        calls.emplace_back(std::move(instance), &proto<Class, Member>);
+    Connection connect(instance_type<Class> instance) {
+        assert(instance);
+        void *target = instance.get();
+        return attach(call_type{std::move(instance), target, &proto<Class, Member>});
     }
 
     /**
@@ -129,9 +329,9 @@ public:
      */
     template<void(*Function)(Args...)>
     void disconnect() {
-        calls.erase(std::remove_if(calls.begin(), calls.end(),
-            [](const call_type &call) { return call.second == &proto<Function> && !call.first.lock(); }
-        ), calls.end());
+        detach([](const call_type &call) {
+            return call.proto == &proto<Function> && unbound(call);
+        });
     }
 
     /**
@@ -142,9 +342,12 @@ public:
      */
     template<typename Class, void(Class::*Member)(Args...)>
     void disconnect(instance_type<Class> instance) {
-        calls.erase(std::remove_if(calls.begin(), calls.end(),
-            [instance{std::move(instance)}](const call_type &call) { return call.second == &proto<Class, Member> && call.first.lock() == instance; }
-        ), calls.end());
+        const void *target = instance.get();
+        const std::weak_ptr<void> owner = std::move(instance);
+
+        detach([&owner, target](const call_type &call) {
+            return call.proto == &proto<Class, Member> && same(call, owner, target);
+        });
     }
 
     /**
@@ -154,26 +357,71 @@ public:
      */
     template<typename Class>
     void disconnect(instance_type<Class> instance) {
-        calls.erase(std::remove_if(calls.begin(), calls.end(),
-            [instance{std::move(instance)}](const call_type &call) { return call.first.lock() == instance; }
-        ), calls.end());
+        const void *target = instance.get();
+        const std::weak_ptr<void> owner = std::move(instance);
+
+        detach([&owner, target](const call_type &call) {
+            return same(call, owner, target);
+        });
+    }
+
+    /**
+     * @brief Disconnects a listener by means of its connection in constant
+     * time.
+     *
+     * Connections that refer to listeners already disconnected are ignored.
+     *
+     * @param conn A connection object returned by the signal.
+     */
+    void disconnect(const Connection &conn) noexcept {
+        if(conn.index < calls.size()) {
+            const auto &slot = calls[conn.index];
+
+            if(slot.call.proto && slot.stamp == conn.stamp) {
+                detach(conn.index);
+            }
+        }
     }
 
     /**
      * @brief Triggers a signal.
      *
-     * All the listeners are notified. Order isn't guaranteed.
+     * All the listeners are notified. Order isn't guaranteed.<br/>
+     * Instances are locked for the duration of the notification. Use a batch
+     * to publish many events in a row.
      *
      * @param args Arguments to use to invoke listeners.
      */
     void publish(Args... args) {
-        for(auto it = calls.rbegin(), end = calls.rend(); it != end; it++) {
-            if(!(it->second)(it->first, args...)) {
-                calls.erase(std::next(it).base());
+        // detaching a listener can release trailing slots, size is read every time
+        for(size_type pos = 0; pos < calls.size(); ++pos) {
+            const auto &call = calls[pos].call;
+
+            if(call.proto) {
+                if(unbound(call)) {
+                    call.proto(nullptr, args...);
+                } else if(auto ptr = call.instance.lock()) {
+                    call.proto(ptr.get(), args...);
+                } else {
+                    detach(pos);
+                }
             }
         }
     }
 
+    /**
+     * @brief Pins the listeners to notify them more than once.
+     *
+     * Instances are locked once when the batch is created rather than every
+     * time an event is published. Listeners the instances of which have
+     * expired are disconnected in the meantime.
+     *
+     * @return A batch that refers to the listeners currently connected.
+     */
+    Batch batch() {
+        return Batch{*this};
+    }
+
     /**
      * @brief Swaps listeners between the two signals.
      * @param lhs A valid signal object.
@@ -182,25 +430,48 @@ public:
     friend void swap(Signal &lhs, Signal &rhs) {
         using std::swap;
         swap(lhs.calls, rhs.calls);
+        swap(lhs.dead, rhs.dead);
+        swap(lhs.counter, rhs.counter);
     }
 
     /**
      * @brief Checks if the contents of the two signals are identical.
      *
      * Two signals are identical if they have the same size and the same
-     * listeners registered exactly in the same order.
+     * listeners stored exactly in the same order.<br/>
+     * Slots of disconnected listeners are reused, therefore the order in which
+     * listeners are stored can differ from the order in which they were
+     * connected.
      *
      * @param other Signal with which to compare.
      * @return True if the two signals are identical, false otherwise.
      */
     bool operator==(const Signal &other) const noexcept {
-        return std::equal(calls.cbegin(), calls.cend(), other.calls.cbegin(), other.calls.cend(), [](const auto &lhs, const auto &rhs) {
-            return (lhs.second == rhs.second) && (lhs.first.lock() == rhs.first.lock());
-        });
+        auto lhs = calls.cbegin();
+        auto rhs = other.calls.cbegin();
+        bool equal = true;
+
+        // free slots don't take part in the comparison
+        while(equal) {
+            for(; lhs != calls.cend() && !lhs->call.proto; ++lhs);
+            for(; rhs != other.calls.cend() && !rhs->call.proto; ++rhs);
+
+            if(lhs == calls.cend() || rhs == other.calls.cend()) {
+                break;
+            }
+
+            equal = (lhs->call.proto == rhs->call.proto) && same(lhs->call, rhs->call.instance, rhs->call.target);
+            ++lhs;
+            ++rhs;
+        }
+
+        return equal && lhs == calls.cend() && rhs == other.calls.cend();
     }
 
 private:
-    std::vector<call_type> calls;
+    std::vector<slot_type> calls;
+    size_type dead{};
+    std::uint32_t counter{};
 };
 
 
@@ -208,7 +479,7 @@ private:
  * @brief Checks if the contents of the two signals are different.
  *
  * Two signals are identical if they have the same size and the same
- * listeners registered exactly in the same order.
+ * listeners stored exactly in the same order.
  *
  * @tparam Args Types of arguments of a function type.
  * @param lhs A valid signal object.
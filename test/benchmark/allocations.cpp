@@ -0,0 +1,96 @@
+#include <cstdlib>
+#include <cstddef>
+#include <atomic>
+#include <new>
+#include "allocations.hpp"
+
+namespace {
+
+std::atomic<std::size_t> allocated{0};
+std::atomic<std::size_t> highest{0};
+
+// the size of the block is stored in front of it, the offset keeps the alignment
+constexpr std::size_t offset = alignof(std::max_align_t);
+
+void * allocate(std::size_t size) noexcept {
+    auto *block = static_cast<char *>(std::malloc(size + offset));
+    void *ptr = nullptr;
+
+    if(block) {
+        *reinterpret_cast<std::size_t *>(block) = size;
+        const auto now = (allocated += size);
+        auto prev = highest.load();
+
+        while(prev < now && !highest.compare_exchange_weak(prev, now)) {}
+
+        ptr = block + offset;
+    }
+
+    return ptr;
+}
+
+void deallocate(void *ptr) noexcept {
+    if(ptr) {
+        auto *block = static_cast<char *>(ptr) - offset;
+        allocated -= *reinterpret_cast<std::size_t *>(block);
+        std::free(block);
+    }
+}
+
+}
+
+std::size_t Allocations::current() noexcept {
+    return allocated;
+}
+
+std::size_t Allocations::peak() noexcept {
+    return highest;
+}
+
+std::size_t Allocations::rebase() noexcept {
+    const std::size_t now = allocated;
+    highest = now;
+    return now;
+}
+
+void * operator new(std::size_t size) {
+    auto *ptr = allocate(size);
+    return ptr ? ptr : throw std::bad_alloc{};
+}
+
+void * operator new[](std::size_t size) {
+    auto *ptr = allocate(size);
+    return ptr ? ptr : throw std::bad_alloc{};
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
@@ -0,0 +1,38 @@
+#ifndef ENTT_TEST_BENCHMARK_ALLOCATIONS_HPP
+#define ENTT_TEST_BENCHMARK_ALLOCATIONS_HPP
+
+
+#include <cstddef>
+
+
+/**
+ * @brief Counters for the memory allocated by means of the global operator new.
+ *
+ * The benchmark target replaces the global allocation functions (see
+ * allocations.cpp) so that every byte requested through them is accounted.
+ * Counters are updated atomically, allocations performed by other threads are
+ * accounted as well.
+ */
+struct Allocations final {
+    /**
+     * @brief Returns the number of bytes currently allocated.
+     * @return The number of bytes currently allocated.
+     */
+    static std::size_t current() noexcept;
+
+    /**
+     * @brief Returns the highest number of bytes allocated since the last
+     * rebase.
+     * @return The highest number of bytes allocated.
+     */
+    static std::size_t peak() noexcept;
+
+    /**
+     * @brief Resets the peak to the number of bytes currently allocated.
+     * @return The number of bytes currently allocated.
+     */
+    static std::size_t rebase() noexcept;
+};
+
+
+#endif // ENTT_TEST_BENCHMARK_ALLOCATIONS_HPP
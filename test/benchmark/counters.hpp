@@ -0,0 +1,161 @@
+#ifndef ENTT_TEST_BENCHMARK_COUNTERS_HPP
+#define ENTT_TEST_BENCHMARK_COUNTERS_HPP
+
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+
+#if defined __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * @brief Hardware performance counters read around the timed runs.
+ *
+ * On Linux counters are read by means of `perf_event_open`. Each counter is
+ * opened on its own, so that a missing one (as an example, last level cache
+ * misses in many virtual machines) doesn't prevent the others from working.
+ * Counters that cannot be opened (containers, restrictive values of
+ * `perf_event_paranoid`, other platforms) are simply reported as unavailable.
+ *
+ * Values are scaled when the kernel multiplexes counters.
+ */
+class Counters final {
+#if defined __linux__
+    static int open(std::uint32_t type, std::uint64_t config) noexcept {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static constexpr std::uint64_t cache(std::uint64_t id) noexcept {
+        return id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+#endif
+
+public:
+    /*! @brief Events tracked by the counters. */
+    enum Event: std::size_t {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        L1_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        SIZE
+    };
+
+    /*! @brief Values read from the counters, negative if unavailable. */
+    using values_type = std::array<double, SIZE>;
+
+    /**
+     * @brief Returns the name of an event.
+     * @param event A valid event.
+     * @return The name of the event.
+     */
+    static const char * name(std::size_t event) noexcept {
+        static const char *names[] = { "cycles", "instructions", "l1_misses", "llc_misses", "branch_misses" };
+        return names[event];
+    }
+
+    /*! @brief Opens the counters supported by the platform, if any. */
+    Counters() noexcept {
+        fds.fill(-1);
+
+#if defined __linux__
+        fds[CYCLES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds[INSTRUCTIONS] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds[L1_MISSES] = open(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D));
+        fds[LLC_MISSES] = open(PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_LL));
+        fds[BRANCH_MISSES] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    /*! @brief Copying counters isn't allowed. */
+    Counters(const Counters &) = delete;
+    /*! @brief Copying counters isn't allowed. @return These counters. */
+    Counters & operator=(const Counters &) = delete;
+
+    /*! @brief Closes the counters. */
+    ~Counters() {
+#if defined __linux__
+        for(auto fd: fds) {
+            if(fd != -1) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Checks whether at least a counter is available.
+     * @return True if at least a counter is available, false otherwise.
+     */
+    bool available() const noexcept {
+        bool result = false;
+
+        for(auto fd: fds) {
+            result = result || (fd != -1);
+        }
+
+        return result;
+    }
+
+    /*! @brief Resets and starts the counters. */
+    void start() noexcept {
+#if defined __linux__
+        for(auto fd: fds) {
+            if(fd != -1) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops the counters and returns their values.
+     * @return The values of the counters, negative for those unavailable.
+     */
+    values_type stop() noexcept {
+        values_type values;
+        values.fill(-1.);
+
+#if defined __linux__
+        for(auto fd: fds) {
+            if(fd != -1) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+
+        for(std::size_t pos = 0; pos < SIZE; ++pos) {
+            // value, time enabled, time running
+            std::uint64_t data[3];
+
+            if(fds[pos] != -1 && read(fds[pos], data, sizeof(data)) == sizeof(data) && data[2]) {
+                values[pos] = double(data[0]) * double(data[1]) / double(data[2]);
+            }
+        }
+#endif
+
+        return values;
+    }
+
+private:
+    std::array<int, SIZE> fds;
+};
+
+
+#endif // ENTT_TEST_BENCHMARK_COUNTERS_HPP
@@ -0,0 +1,447 @@
+#ifndef ENTT_TEST_BENCHMARK_HARNESS_HPP
+#define ENTT_TEST_BENCHMARK_HARNESS_HPP
+
+
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstddef>
+#include <utility>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <cmath>
+#include "counters.hpp"
+
+
+/**
+ * @brief Minimal harness for repeatable benchmarks.
+ *
+ * Each scenario is run a few times to warm up caches and allocators, then it's
+ * timed over a number of repetitions with a steady clock. Medians and 99th
+ * percentiles are reported along with the time per element, both on the
+ * standard output and optionally in JSON and CSV files.<br/>
+ * When a baseline is provided (a CSV file written by a previous run), medians
+ * are compared against it and the harness reports a failure if any scenario
+ * got slower than the given threshold.
+ *
+ * Options are parsed from the command line:
+ *
+ * * `--warmup=N`: untimed runs per scenario (default 1).
+ * * `--repetitions=N`: timed runs per scenario (default 5).
+ * * `--json=FILE`: writes the results in JSON format.
+ * * `--csv=FILE`: writes the results in CSV format.
+ * * `--baseline=FILE`: compares the results with a previous CSV file.
+ * * `--threshold=X`: relative slowdown tolerated by comparisons (default 0.1).
+ * * `--counters`: reads hardware performance counters during the timed runs
+ *   and reports them per element, if the platform supports them.
+ *
+ * Memory footprints aren't timed, they're reported on the standard output and
+ * in the JSON file only.
+ */
+class Harness final {
+    using clock_type = std::chrono::steady_clock;
+
+    Harness() = default;
+
+    static std::string quote(const std::string &str) {
+        std::string result{"\""};
+
+        for(auto chr: str) {
+            result += chr;
+
+            if(chr == '"') {
+                result += chr;
+            }
+        }
+
+        return result + '"';
+    }
+
+    static std::string escape(const std::string &str) {
+        std::string result;
+
+        for(auto chr: str) {
+            result += ((chr == '"' || chr == '\\') ? std::string{'\\', chr} : std::string{chr});
+        }
+
+        return result;
+    }
+
+    static std::vector<std::string> split(const std::string &line) {
+        std::vector<std::string> fields(1);
+        bool quoted = false;
+
+        for(std::size_t pos = 0; pos < line.size(); ++pos) {
+            const auto chr = line[pos];
+
+            if(chr == '"') {
+                if(quoted && pos + 1 < line.size() && line[pos + 1] == '"') {
+                    fields.back() += chr;
+                    ++pos;
+                } else {
+                    quoted = !quoted;
+                }
+            } else if(chr == ',' && !quoted) {
+                fields.emplace_back();
+            } else {
+                fields.back() += chr;
+            }
+        }
+
+        return fields;
+    }
+
+public:
+    /*! @brief Statistics collected for a scenario, times in nanoseconds. */
+    struct Result final {
+        std::string name;
+        std::size_t elements;
+        std::size_t repetitions;
+        double median;
+        double p99;
+        double min;
+        double mean;
+        // per element, negative if unavailable
+        Counters::values_type counters;
+
+        double perElement() const noexcept {
+            return elements ? (median / elements) : median;
+        }
+    };
+
+    /*! @brief Memory used by a scenario, in bytes. */
+    struct Footprint final {
+        std::string name;
+        std::size_t elements;
+        std::size_t peak;
+        std::size_t steady;
+
+        double peakPerElement() const noexcept {
+            return elements ? (double(peak) / elements) : double(peak);
+        }
+
+        double steadyPerElement() const noexcept {
+            return elements ? (double(steady) / elements) : double(steady);
+        }
+    };
+
+    /*! @brief Options that drive the harness. */
+    struct Options final {
+        std::size_t warmup{1};
+        std::size_t repetitions{5};
+        std::string json{};
+        std::string csv{};
+        std::string baseline{};
+        double threshold{.1};
+        bool counters{false};
+    };
+
+    Harness(const Harness &) = delete;
+    Harness & operator=(const Harness &) = delete;
+
+    static Harness & instance() {
+        static Harness harness{};
+        return harness;
+    }
+
+    bool configure(const std::string &arg) {
+        const auto value = [&arg](const std::string &prefix) {
+            return arg.compare(0, prefix.size(), prefix) ? nullptr : arg.c_str() + prefix.size();
+        };
+
+        const char *str = nullptr;
+
+        if(arg == "--counters") {
+            options.counters = true;
+            str = "";
+        } else if((str = value("--warmup="))) {
+            options.warmup = std::stoul(str);
+        } else if((str = value("--repetitions="))) {
+            options.repetitions = std::max<std::size_t>(1u, std::stoul(str));
+        } else if((str = value("--json="))) {
+            options.json = str;
+        } else if((str = value("--csv="))) {
+            options.csv = str;
+        } else if((str = value("--baseline="))) {
+            options.baseline = str;
+        } else if((str = value("--threshold="))) {
+            options.threshold = std::stod(str);
+        }
+
+        return str != nullptr;
+    }
+
+    /**
+     * @brief Runs and times a scenario.
+     *
+     * The setup function is invoked before each run and it isn't timed, it's
+     * meant to restore the state consumed by the previous run.
+     *
+     * @param name Unique name of the scenario, used to match baselines.
+     * @param elements Number of elements processed by a run.
+     * @param setup Untimed function invoked before each run.
+     * @param func Function to time.
+     * @return The statistics collected for the scenario.
+     */
+    template<typename Setup, typename Func>
+    Result measure(const std::string &name, std::size_t elements, Setup setup, Func func) {
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        Counters::values_type counted;
+        counted.fill(0.);
+
+        if(options.counters && !counters) {
+            counters = std::make_unique<Counters>();
+
+            if(!counters->available()) {
+                std::cerr << "Hardware counters unavailable, reporting wall time only" << std::endl;
+            }
+        }
+
+        for(std::size_t run = 0; run < options.warmup; ++run) {
+            setup();
+            func();
+        }
+
+        for(std::size_t run = 0; run < options.repetitions; ++run) {
+            setup();
+
+            if(counters) {
+                counters->start();
+            }
+
+            const auto start = clock_type::now();
+            func();
+            const auto end = clock_type::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+
+            if(counters) {
+                const auto values = counters->stop();
+
+                for(std::size_t pos = 0; pos < Counters::SIZE; ++pos) {
+                    counted[pos] = (values[pos] < 0. || counted[pos] < 0.) ? -1. : (counted[pos] + values[pos]);
+                }
+            }
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        const auto size = samples.size();
+        const auto median = (size % 2) ? samples[size / 2] : ((samples[size / 2 - 1] + samples[size / 2]) / 2.);
+        // nearest-rank percentile
+        const auto p99 = samples[std::size_t(std::ceil(.99 * size)) - 1];
+        double total = 0.;
+
+        for(auto sample: samples) {
+            total += sample;
+        }
+
+        Result result{name, elements, size, median, p99, samples.front(), total / size, {}};
+        result.counters.fill(-1.);
+
+        for(std::size_t pos = 0; counters && pos < Counters::SIZE; ++pos) {
+            if(counted[pos] >= 0.) {
+                result.counters[pos] = counted[pos] / (double(size) * double(elements ? elements : 1u));
+            }
+        }
+
+        results.push_back(result);
+
+        std::cout << std::fixed << std::setprecision(3) << name << ": median " << (median / 1e6) << " ms, p99 " << (p99 / 1e6)
+                  << " ms, " << result.perElement() << " ns/element (" << size << " runs)" << std::endl;
+
+        if(counters && counters->available()) {
+            std::cout << "    per element:";
+
+            for(std::size_t pos = 0; pos < Counters::SIZE; ++pos) {
+                if(result.counters[pos] >= 0.) {
+                    std::cout << ' ' << Counters::name(pos) << ' ' << result.counters[pos];
+                }
+            }
+
+            if(result.counters[Counters::CYCLES] > 0. && result.counters[Counters::INSTRUCTIONS] >= 0.) {
+                std::cout << ", ipc " << (result.counters[Counters::INSTRUCTIONS] / result.counters[Counters::CYCLES]);
+            }
+
+            std::cout << std::endl;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Runs and times a scenario that doesn't consume its state.
+     * @param name Unique name of the scenario, used to match baselines.
+     * @param elements Number of elements processed by a run.
+     * @param func Function to time.
+     * @return The statistics collected for the scenario.
+     */
+    template<typename Func>
+    Result measure(const std::string &name, std::size_t elements, Func func) {
+        return measure(name, elements, []() {}, std::move(func));
+    }
+
+    /**
+     * @brief Records the memory used by a scenario.
+     * @param name Unique name of the scenario.
+     * @param elements Number of live elements.
+     * @param peak Highest number of bytes allocated by the scenario.
+     * @param steady Number of bytes still allocated by the scenario.
+     * @return The footprint of the scenario.
+     */
+    Footprint footprint(const std::string &name, std::size_t elements, std::size_t peak, std::size_t steady) {
+        const Footprint result{name, elements, peak, steady};
+        footprints.push_back(result);
+
+        std::cout << std::fixed << std::setprecision(3) << name << ": peak " << result.peakPerElement() << " bytes/element, steady "
+                  << result.steadyPerElement() << " bytes/element (" << elements << " elements)" << std::endl;
+
+        return result;
+    }
+
+    /**
+     * @brief Writes the results and compares them with the baseline, if any.
+     * @return False in case of regressions or errors, true otherwise.
+     */
+    bool report() const {
+        bool success = true;
+
+        if(!options.json.empty()) {
+            std::ofstream out{options.json};
+            out << std::setprecision(17) << "{\"benchmarks\":[";
+
+            for(std::size_t pos = 0; pos < results.size(); ++pos) {
+                const auto &result = results[pos];
+
+                out << (pos ? "," : "") << "{\"name\":\"" << escape(result.name) << "\",\"elements\":" << result.elements << ",\"repetitions\":" << result.repetitions
+                    << ",\"median_ns\":" << result.median << ",\"p99_ns\":" << result.p99 << ",\"min_ns\":" << result.min << ",\"mean_ns\":" << result.mean
+                    << ",\"ns_per_element\":" << result.perElement();
+
+                for(std::size_t event = 0; event < Counters::SIZE; ++event) {
+                    if(result.counters[event] >= 0.) {
+                        out << ",\"" << Counters::name(event) << "_per_element\":" << result.counters[event];
+                    }
+                }
+
+                out << "}";
+            }
+
+            out << "],\"footprints\":[";
+
+            for(std::size_t pos = 0; pos < footprints.size(); ++pos) {
+                const auto &result = footprints[pos];
+
+                out << (pos ? "," : "") << "{\"name\":\"" << escape(result.name) << "\",\"elements\":" << result.elements
+                    << ",\"peak_bytes\":" << result.peak << ",\"steady_bytes\":" << result.steady << ",\"peak_bytes_per_element\":"
+                    << result.peakPerElement() << ",\"steady_bytes_per_element\":" << result.steadyPerElement() << "}";
+            }
+
+            out << "]}" << std::endl;
+            success = success && out.good();
+        }
+
+        if(!options.csv.empty()) {
+            std::ofstream out{options.csv};
+            out << std::setprecision(17) << "name,elements,repetitions,median_ns,p99_ns,min_ns,mean_ns,ns_per_element";
+
+            for(std::size_t event = 0; event < Counters::SIZE; ++event) {
+                out << ',' << Counters::name(event) << "_per_element";
+            }
+
+            out << std::endl;
+
+            for(auto &&result: results) {
+                out << quote(result.name) << ',' << result.elements << ',' << result.repetitions << ',' << result.median << ','
+                    << result.p99 << ',' << result.min << ',' << result.mean << ',' << result.perElement();
+
+                // unavailable counters are left empty
+                for(auto value: result.counters) {
+                    out << ',';
+
+                    if(value >= 0.) {
+                        out << value;
+                    }
+                }
+
+                out << std::endl;
+            }
+
+            success = success && out.good();
+        }
+
+        if(!options.baseline.empty()) {
+            std::ifstream in{options.baseline};
+            std::unordered_map<std::string, double> baseline;
+            std::string line;
+
+            if(!in) {
+                std::cerr << "Unable to read the baseline " << options.baseline << std::endl;
+                return false;
+            }
+
+            // the first line contains the names of the columns
+            std::getline(in, line);
+
+            while(std::getline(in, line)) {
+                const auto fields = split(line);
+
+                if(fields.size() > 3) {
+                    baseline[fields[0]] = std::stod(fields[3]);
+                }
+            }
+
+            for(auto &&result: results) {
+                const auto it = baseline.find(result.name);
+
+                if(it != baseline.cend() && it->second > 0.) {
+                    const auto delta = result.median / it->second - 1.;
+                    const bool regression = delta > options.threshold;
+                    success = success && !regression;
+
+                    std::cout << std::fixed << std::setprecision(1) << (regression ? "REGRESSION " : "") << result.name
+                              << ": " << (delta >= 0. ? "+" : "") << (delta * 100.) << "%" << std::endl;
+                }
+            }
+        }
+
+        return success;
+    }
+
+private:
+    Options options{};
+    std::vector<Result> results{};
+    std::vector<Footprint> footprints{};
+    std::unique_ptr<Counters> counters{};
+};
+
+
+/**
+ * @brief Runs and times a scenario by means of the shared harness.
+ * @tparam Args Types of arguments to forward to the harness.
+ * @param args Arguments to forward to the harness.
+ * @return The statistics collected for the scenario.
+ */
+template<typename... Args>
+Harness::Result measure(Args&&... args) {
+    return Harness::instance().measure(std::forward<Args>(args)...);
+}
+
+
+/**
+ * @brief Records the memory used by a scenario by means of the shared harness.
+ * @param name Unique name of the scenario.
+ * @param elements Number of live elements.
+ * @param peak Highest number of bytes allocated by the scenario.
+ * @param steady Number of bytes still allocated by the scenario.
+ * @return The footprint of the scenario.
+ */
+inline Harness::Footprint footprint(const std::string &name, std::size_t elements, std::size_t peak, std::size_t steady) {
+    return Harness::instance().footprint(name, elements, peak, steady);
+}
+
+
+#endif // ENTT_TEST_BENCHMARK_HARNESS_HPP
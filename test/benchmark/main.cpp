@@ -0,0 +1,20 @@
+#include <iostream>
+#include <string>
+#include <gtest/gtest.h>
+#include "harness.hpp"
+
+int main(int argc, char **argv) {
+    // gtest removes its own flags, what remains is for the harness
+    ::testing::InitGoogleTest(&argc, argv);
+    auto &harness = Harness::instance();
+
+    for(int pos = 1; pos < argc; ++pos) {
+        if(!harness.configure(argv[pos])) {
+            std::cerr << "Unknown option " << argv[pos] << std::endl;
+            return 1;
+        }
+    }
+
+    const auto result = RUN_ALL_TESTS();
+    return (harness.report() && !result) ? 0 : 1;
+}
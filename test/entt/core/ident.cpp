@@ -30,4 +30,7 @@ TEST(Identifier, SingleType) {
     constexpr auto ID = entt::ident<A>;
     std::integral_constant<decltype(ID)::identifier_type, ID.get()> ic;
     (void)ic;
+
+    ASSERT_EQ(ID.get(), ID.get<A>());
+    ASSERT_EQ(ID.get(), ID.get<const A &>());
 }
@@ -0,0 +1,70 @@
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/core/type_hash.hpp>
+
+struct A {};
+struct B {};
+
+template<std::size_t>
+struct T {};
+
+TEST(TypeHash, Functionalities) {
+    constexpr auto a = entt::TypeHash<A>::value();
+    constexpr auto b = entt::TypeHash<B>::value();
+
+    ASSERT_NE(a, b);
+    ASSERT_EQ(a, entt::TypeHash<A>::value());
+    ASSERT_NE(entt::TypeHash<int>::value(), entt::TypeHash<unsigned int>::value());
+    ASSERT_NE(entt::TypeHash<T<0>>::value(), entt::TypeHash<T<1>>::value());
+
+    // test uses in constant expressions
+    switch(entt::TypeHash<B>::value()) {
+    case entt::TypeHash<A>::value():
+        FAIL();
+        break;
+    case entt::TypeHash<B>::value():
+        SUCCEED();
+    }
+}
+
+template<std::size_t... Index>
+auto hashes(std::index_sequence<Index...>) {
+    return std::vector<entt::HashedString::hash_type>{ entt::TypeHash<T<Index>>::value()... };
+}
+
+TEST(HashIndex, Functionalities) {
+    entt::HashIndex index;
+
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(index.size(), entt::HashIndex::size_type{0});
+    ASSERT_EQ(index.find(entt::TypeHash<A>::value()), entt::HashIndex::size_type{entt::HashIndex::null});
+
+    ASSERT_EQ(index.insert(entt::TypeHash<A>::value()), entt::HashIndex::size_type{0});
+    ASSERT_EQ(index.insert(entt::TypeHash<B>::value()), entt::HashIndex::size_type{1});
+    ASSERT_EQ(index.insert(entt::TypeHash<A>::value()), entt::HashIndex::size_type{0});
+
+    ASSERT_FALSE(index.empty());
+    ASSERT_EQ(index.size(), entt::HashIndex::size_type{2});
+    ASSERT_EQ(index.find(entt::TypeHash<A>::value()), entt::HashIndex::size_type{0});
+    ASSERT_EQ(index.find(entt::TypeHash<B>::value()), entt::HashIndex::size_type{1});
+    ASSERT_EQ(index.find(entt::TypeHash<int>::value()), entt::HashIndex::size_type{entt::HashIndex::null});
+
+    index.clear();
+
+    ASSERT_TRUE(index.empty());
+    ASSERT_EQ(index.find(entt::TypeHash<A>::value()), entt::HashIndex::size_type{entt::HashIndex::null});
+
+    // forces a few rehashes
+    const auto values = hashes(std::make_index_sequence<64>{});
+
+    for(entt::HashIndex::size_type pos = 0; pos < values.size(); ++pos) {
+        ASSERT_EQ(index.insert(values[pos]), pos);
+    }
+
+    for(entt::HashIndex::size_type pos = 0; pos < values.size(); ++pos) {
+        ASSERT_EQ(index.find(values[pos]), pos);
+    }
+
+    ASSERT_EQ(index.size(), entt::HashIndex::size_type{64});
+}
@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
-#include <iostream>
+#include <algorithm>
 #include <cstddef>
-#include <chrono>
+#include <iterator>
+#include <string>
 #include <vector>
+#include <thread>
+#include <entt/entity/hierarchy.hpp>
 #include <entt/entity/registry.hpp>
+#include <entt/entity/static_registry.hpp>
+#include <entt/entity/system_graph.hpp>
+#include "benchmark/allocations.hpp"
+#include "benchmark/harness.hpp"
 
 struct Position {
     uint64_t x;
@@ -18,338 +25,767 @@ struct Velocity {
 template<std::size_t>
 struct Comp {};
 
-struct Timer final {
-    Timer(): start{std::chrono::system_clock::now()} {}
+template<std::size_t>
+struct Value { double value; };
 
-    void elapsed() {
-        auto now = std::chrono::system_clock::now();
-        std::cout << std::chrono::duration<double>(now - start).count() << " seconds" << std::endl;
-    }
+struct Point {
+    float x;
+    float y;
+};
 
-private:
-    std::chrono::time_point<std::chrono::system_clock> start;
+struct Transform {
+    float local;
+    float world;
 };
 
-TEST(Benchmark, Construct) {
-    entt::DefaultRegistry registry;
+struct Parent {
+    entt::DefaultRegistry::entity_type entity;
+};
 
-    std::cout << "Constructing 10000000 entities" << std::endl;
+float propagate(entt::DefaultRegistry &registry, entt::DefaultRegistry::entity_type entity) {
+    auto &transform = registry.get<Transform>(entity);
+    const auto parent = registry.has<Parent>(entity) ? propagate(registry, registry.get<Parent>(entity).entity) : 0.f;
+    return (transform.world = parent + transform.local);
+}
 
-    Timer timer;
+template<std::size_t... Index>
+void attachSystems(entt::SystemGraph<double> &graph, entt::DefaultRegistry &registry, std::index_sequence<Index...>) {
+    using accumulator_type = int[];
+
+    // ten independent systems that write their own component ...
+    accumulator_type first = { 0, (graph.attach<entt::Read<Position>, entt::Write<Value<Index>>>([&registry](auto delta) {
+        registry.view<Position, Value<Index>>().each([delta](auto, const auto &position, auto &value) {
+            value.value += position.x * delta;
+        });
+    }), 0)... };
+
+    // ... and ten systems that depend on them
+    accumulator_type second = { 0, (graph.attach<entt::Read<Value<Index>>, entt::Write<Value<Index+10>>>([&registry](auto delta) {
+        registry.view<Value<Index>, Value<Index+10>>().each([delta](auto, const auto &in, auto &out) {
+            out.value = out.value * delta + in.value;
+        });
+    }), 0)... };
+
+    (void)first;
+    (void)second;
+}
 
-    for(uint64_t i = 0; i < 10000000L; i++) {
-        registry.create();
+template<std::size_t... Index>
+void createEntities(entt::DefaultRegistry &registry, std::uint64_t count, std::index_sequence<Index...>) {
+    for(std::uint64_t i = 0; i < count; i++) {
+        registry.create<Position, Value<Index>..., Value<Index+10>...>();
     }
-
-    timer.elapsed();
 }
 
-TEST(Benchmark, Destroy) {
-    entt::DefaultRegistry registry;
-    std::vector<entt::DefaultRegistry::entity_type> entities{};
+using StaticRegistry = entt::StaticRegistry<std::uint32_t, Position, Velocity>;
 
-    std::cout << "Destroying 10000000 entities" << std::endl;
+template<typename Func>
+void measureFootprint(const std::string &name, Func func) {
+    const auto base = Allocations::rebase();
+    std::size_t live{};
+    std::size_t peak{};
+    std::size_t steady{};
 
-    for(uint64_t i = 0; i < 10000000L; i++) {
-        entities.push_back(registry.create());
+    {
+        entt::DefaultRegistry registry;
+        live = func(registry);
+        steady = Allocations::current() - base;
+        peak = Allocations::peak() - base;
     }
 
-    Timer timer;
+    footprint(name, live, peak, steady);
+}
 
-    for(auto entity: entities) {
-        registry.destroy(entity);
+template<typename... Component>
+std::size_t createWith(entt::DefaultRegistry &registry, std::size_t count) {
+    for(std::size_t i = 0; i < count; i++) {
+        registry.create<Component...>();
     }
 
-    timer.elapsed();
+    return count;
 }
 
-TEST(Benchmark, IterateCreateDeleteSingleComponent) {
+template<std::size_t... Index>
+std::size_t createWithTags(entt::DefaultRegistry &registry, std::size_t count, std::index_sequence<Index...>) {
+    return createWith<Comp<Index>...>(registry, count);
+}
+
+TEST(Benchmark, Construct) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Looping 10000 times creating and deleting a random number of entities" << std::endl;
+    measure("Constructing 10000000 entities", 10000000L, [&registry]() {
+        registry = entt::DefaultRegistry{};
+    }, [&registry]() {
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            registry.create();
+        }
+    });
+}
 
-    Timer timer;
+TEST(Benchmark, Destroy) {
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities{};
 
-    auto view = registry.view<Position>();
+    measure("Destroying 10000000 entities", 10000000L, [&]() {
+        registry = entt::DefaultRegistry{};
+        entities.clear();
 
-    for(int i = 0; i < 10000; i++) {
-        for(int j = 0; j < 10000; j++) {
-            registry.create<Position>();
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            entities.push_back(registry.create());
+        }
+    }, [&]() {
+        for(auto entity: entities) {
+            registry.destroy(entity);
         }
+    });
+}
+
+TEST(Benchmark, Clone) {
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities{};
+    entt::DefaultRegistry::entity_type prototype{};
+
+    measure("Cloning 1000000 entities, five components", 1000000L, [&]() {
+        registry = entt::DefaultRegistry{};
+        entities.clear();
+        entities.reserve(1000000L);
+        prototype = registry.create<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>();
+    }, [&]() {
+        registry.clone(prototype, 1000000L, std::back_inserter(entities));
+    });
+}
+
+TEST(Benchmark, IterateCreateDeleteSingleComponent) {
+    entt::DefaultRegistry registry;
 
-        for(auto entity: view) {
-            if(rand() % 2 == 0) {
-                registry.destroy(entity);
+    measure("Looping 10000 times creating and deleting a random number of entities", 10000L * 10000L, [&registry]() {
+        registry = entt::DefaultRegistry{};
+        srand(0);
+    }, [&registry]() {
+        auto view = registry.view<Position>();
+
+        for(int i = 0; i < 10000; i++) {
+            for(int j = 0; j < 10000; j++) {
+                registry.create<Position>();
             }
-        }
-    }
 
-    timer.elapsed();
+            for(auto entity: view) {
+                if(rand() % 2 == 0) {
+                    registry.destroy(entity);
+                }
+            }
+        }
+    });
 }
 
 TEST(Benchmark, IterateSingleComponent10M) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, one component" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position>();
     }
 
-    Timer timer;
-    registry.view<Position>().each([](auto, auto &) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, one component", 10000000L, [&registry]() {
+        registry.view<Position>().each([](auto, auto &) {});
+    });
+}
+
+TEST(Benchmark, IterateSingleComponentRange10M) {
+    for(auto policy: { entt::DeletionPolicy::SWAP_AND_POP, entt::DeletionPolicy::TOMBSTONE }) {
+        entt::DefaultRegistry registry;
+        registry.policy<Position>(policy);
+        uint64_t sum = 0;
+
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            registry.create<Position>();
+        }
+
+        const auto name = std::string{"Iterating over 10000000 entities, one component, range-for, "}
+                + (policy == entt::DeletionPolicy::TOMBSTONE ? "tombstone policy" : "swap-and-pop policy");
+
+        // the sum is used later, the loop can't be optimized away
+        measure(name, 10000000L, [&registry, &sum]() {
+            for(auto entity: registry.view<Position>()) {
+                sum += entity;
+            }
+        });
+
+        ASSERT_NE(sum, uint64_t{});
+    }
 }
 
 TEST(Benchmark, IterateTwoComponents10M) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, two components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity>();
     }
 
-    Timer timer;
-    registry.view<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTwoComponents10MHalf) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, two components, half of the entities have all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity>();
         if(i % 2) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.view<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components, half of the entities have all the components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTwoComponents10MOne) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, two components, only one entity has all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity>();
         if(i == 5000000L) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.view<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components, only one entity has all the components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTwoComponentsPersistent10M) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity>();
 
-    std::cout << "Iterating over 10000000 entities, two components, persistent view" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity>();
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components, persistent view", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTwoComponentsPersistent10MHalf) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity>();
 
-    std::cout << "Iterating over 10000000 entities, two components, persistent view, half of the entities have all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity>();
         if(i % 2) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components, persistent view, half of the entities have all the components", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTwoComponentsPersistent10MOne) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity>();
 
-    std::cout << "Iterating over 10000000 entities, two components, persistent view, only one entity has all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity>();
         if(i == 5000000L) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, two components, persistent view, only one entity has all the components", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateFiveComponents10M) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, five components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>();
     }
 
-    Timer timer;
-    registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, five components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponents10M) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, ten components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
     }
 
-    Timer timer;
-    registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponents10MHalf) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, ten components, half of the entities have all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
         if(i % 2) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components, half of the entities have all the components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponents10MOne) {
     entt::DefaultRegistry registry;
 
-    std::cout << "Iterating over 10000000 entities, ten components, only one entity has all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
         if(i == 5000000L) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components, only one entity has all the components", 10000000L, [&registry]() {
+        registry.view<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateFiveComponentsPersistent10M) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>();
 
-    std::cout << "Iterating over 10000000 entities, five components, persistent view" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>();
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, five components, persistent view", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponentsPersistent10M) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
 
-    std::cout << "Iterating over 10000000 entities, ten components, persistent view" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         registry.create<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components, persistent view", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponentsPersistent10MHalf) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
 
-    std::cout << "Iterating over 10000000 entities, ten components, persistent view, half of the entities have all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
         if(i % 2) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components, persistent view, half of the entities have all the components", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
 TEST(Benchmark, IterateTenComponentsPersistent10MOne) {
     entt::DefaultRegistry registry;
     registry.prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
 
-    std::cout << "Iterating over 10000000 entities, ten components, persistent view, only one entity has all the components" << std::endl;
-
     for(uint64_t i = 0; i < 10000000L; i++) {
         auto entity = registry.create<Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
         if(i == 5000000L) { registry.assign<Position>(entity); }
     }
 
-    Timer timer;
-    registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
-    timer.elapsed();
+    measure("Iterating over 10000000 entities, ten components, persistent view, only one entity has all the components", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>().each([](auto, auto &...) {});
+    });
 }
 
-TEST(Benchmark, SortSingle) {
+TEST(Benchmark, IndexLookup) {
     entt::DefaultRegistry registry;
-    std::vector<entt::DefaultRegistry::entity_type> entities{};
+    std::size_t scanned = 0;
+    std::size_t indexed = 0;
+
+    for(uint64_t i = 0; i < 1000000L; i++) {
+        registry.create<Position>({ i, i });
+    }
+
+    measure("Looking up 1000 entities out of 1000000 entities, one component, scanning", 1000L, [&scanned]() {
+        scanned = 0;
+    }, [&]() {
+        for(uint64_t i = 0; i < 1000L; i++) {
+            registry.view<Position>().each([i, &scanned](auto, const auto &position) {
+                scanned += (position.x == i * 1000);
+            });
+        }
+    });
+
+    registry.index<Position>([](const auto &position) { return position.x; });
+
+    measure("Looking up 1000 entities out of 1000000 entities, one component, indexed", 1000L, [&indexed]() {
+        indexed = 0;
+    }, [&]() {
+        for(uint64_t i = 0; i < 1000L; i++) {
+            indexed += (registry.lookup<Position>(i * 1000) != nullptr);
+        }
+    });
+
+    ASSERT_EQ(scanned, indexed);
+}
+
+TEST(Benchmark, SpatialQuery) {
+    for(auto side: { 1000, 4000, 16000 }) {
+        entt::DefaultRegistry registry;
+        std::vector<entt::DefaultRegistry::entity_type> entities;
+        const auto name = "Querying 100 circles of radius 10 among 1000000 entities, " + std::to_string(side) + "x" + std::to_string(side);
+        std::size_t scanned = 0;
+
+        for(uint64_t i = 0; i < 1000000L; i++) {
+            registry.create<Point>(Point{ float(rand() % side), float(rand() % side) });
+        }
+
+        measure(name + ", scanning", 100L, [&scanned]() {
+            scanned = 0;
+        }, [&]() {
+            for(auto i = 0; i < 100; i++) {
+                const auto x = float(i * side / 100);
+
+                registry.view<Point>().each([x, &scanned](auto, const auto &point) {
+                    const auto dx = point.x - x;
+                    const auto dy = point.y - x;
+                    scanned += (dx * dx + dy * dy <= 100.f);
+                });
+            }
+        });
+
+        registry.grid<Point>(10.f, [](const auto &point) { return std::make_pair(point.x, point.y); });
+
+        measure(name + ", indexed", 100L, [&entities]() {
+            entities.clear();
+        }, [&]() {
+            for(auto i = 0; i < 100; i++) {
+                const auto x = float(i * side / 100);
+                registry.query<Point>(x, x, 10.f, std::back_inserter(entities));
+            }
+        });
+
+        ASSERT_EQ(scanned, entities.size());
+    }
+}
 
-    std::cout << "Sort 150000 entities, one component" << std::endl;
+TEST(Benchmark, PropagateTransforms) {
+    entt::DefaultRegistry registry;
+    entt::Hierarchy<entt::DefaultRegistry::entity_type> hierarchy;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    for(uint64_t i = 0; i < 1000000L; i++) {
+        const auto entity = registry.create<Transform>(Transform{ 1.f, 0.f });
+
+        if(entities.empty() || rand() % 100 == 0) {
+            hierarchy.construct(entity);
+        } else {
+            const auto parent = entities[rand() % entities.size()];
+            registry.assign<Parent>(entity, parent);
+            hierarchy.construct(entity, parent);
+        }
 
-    for(uint64_t i = 0; i < 150000L; i++) {
-        auto entity = registry.create<Position>({ i, i });
         entities.push_back(entity);
     }
 
-    Timer timer;
+    measure("Propagating transforms through a forest of 1000000 entities, parent component", 1000000L, [&registry]() {
+        registry.view<Transform>().each([&registry](auto entity, auto &) {
+            propagate(registry, entity);
+        });
+    });
 
-    registry.sort<Position>([](const auto &lhs, const auto &rhs) {
-        return lhs.x < rhs.x && lhs.y < rhs.y;
+    measure("Propagating transforms through a forest of 1000000 entities, hierarchy", 1000000L, [&]() {
+        hierarchy.each([&registry](auto entity, auto parent) {
+            auto &transform = registry.get<Transform>(entity);
+            transform.world = transform.local + (entity == parent ? 0.f : registry.get<Transform>(parent).world);
+        });
     });
+}
 
-    timer.elapsed();
+TEST(Benchmark, SortSingle) {
+    entt::DefaultRegistry registry;
+
+    measure("Sort 150000 entities, one component", 150000L, [&registry]() {
+        registry = entt::DefaultRegistry{};
+
+        for(uint64_t i = 0; i < 150000L; i++) {
+            registry.create<Position>({ i, i });
+        }
+    }, [&registry]() {
+        registry.sort<Position>([](const auto &lhs, const auto &rhs) {
+            return lhs.x < rhs.x && lhs.y < rhs.y;
+        });
+    });
 }
 
 TEST(Benchmark, SortMulti) {
     entt::DefaultRegistry registry;
+
+    measure("Sort 150000 entities, two components", 150000L, [&registry]() {
+        registry = entt::DefaultRegistry{};
+
+        for(uint64_t i = 0; i < 150000L; i++) {
+            registry.create<Position, Velocity>({ i, i }, { i, i });
+        }
+
+        registry.sort<Position>([](const auto &lhs, const auto &rhs) {
+            return lhs.x < rhs.x && lhs.y < rhs.y;
+        });
+    }, [&registry]() {
+        registry.sort<Velocity, Position>();
+    });
+}
+
+TEST(Benchmark, DestroyTwoComponents) {
+    entt::DefaultRegistry registry;
     std::vector<entt::DefaultRegistry::entity_type> entities{};
 
-    std::cout << "Sort 150000 entities, two components" << std::endl;
+    measure("Destroying 10000000 entities, two components", 10000000L, [&]() {
+        registry = entt::DefaultRegistry{};
+        entities.clear();
 
-    for(uint64_t i = 0; i < 150000L; i++) {
-        auto entity = registry.create<Position, Velocity>({ i, i }, { i, i });
-        entities.push_back(entity);
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            entities.push_back(registry.create<Position, Velocity>());
+        }
+    }, [&]() {
+        for(auto entity: entities) {
+            registry.destroy(entity);
+        }
+    });
+}
+
+TEST(Benchmark, DestroyTwoComponentsRange) {
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities{};
+
+    measure("Destroying 10000000 entities at once, two components", 10000000L, [&]() {
+        registry = entt::DefaultRegistry{};
+        entities.clear();
+
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            entities.push_back(registry.create<Position, Velocity>());
+        }
+    }, [&]() {
+        registry.destroy(entities.cbegin(), entities.cend());
+    });
+}
+
+TEST(Benchmark, RemoveDuringIteration) {
+    for(auto policy: { entt::DeletionPolicy::SWAP_AND_POP, entt::DeletionPolicy::TOMBSTONE }) {
+        entt::DefaultRegistry registry;
+
+        const auto setup = [&registry, policy]() {
+            registry = entt::DefaultRegistry{};
+            registry.policy<Velocity>(policy);
+
+            for(uint64_t i = 0; i < 10000000L; i++) {
+                registry.create<Position, Velocity>({ i, i }, {});
+            }
+        };
+
+        if(policy == entt::DeletionPolicy::TOMBSTONE) {
+            measure("Removing 5000000 components out of 10000000 entities while iterating, tombstones", 10000000L, setup, [&registry]() {
+                registry.view<Position, Velocity>().each([&registry](auto entity, const auto &position, const auto &) {
+                    if(position.x % 2) {
+                        registry.remove<Velocity>(entity);
+                    }
+                });
+
+                registry.compact();
+            });
+        } else {
+            measure("Removing 5000000 components out of 10000000 entities while iterating, buffered", 10000000L, setup, [&registry]() {
+                std::vector<entt::DefaultRegistry::entity_type> buffer;
+
+                registry.view<Position, Velocity>().each([&buffer](auto entity, const auto &position, const auto &) {
+                    if(position.x % 2) {
+                        buffer.push_back(entity);
+                    }
+                });
+
+                for(auto entity: buffer) {
+                    registry.remove<Velocity>(entity);
+                }
+            });
+        }
+
+        ASSERT_EQ(registry.size<Velocity>(), 5000000u);
     }
+}
+
+TEST(Benchmark, StaticConstruct) {
+    StaticRegistry registry;
+
+    measure("Constructing 10000000 entities, static registry", 10000000L, [&registry]() {
+        registry = StaticRegistry{};
+    }, [&registry]() {
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            registry.create();
+        }
+    });
+}
+
+TEST(Benchmark, StaticConstructTwoComponents) {
+    StaticRegistry registry;
+
+    measure("Constructing 10000000 entities, two components, static registry", 10000000L, [&registry]() {
+        registry = StaticRegistry{};
+    }, [&registry]() {
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            registry.create<Position, Velocity>();
+        }
+    });
+}
+
+TEST(Benchmark, StaticDestroyTwoComponents) {
+    StaticRegistry registry;
+    std::vector<StaticRegistry::entity_type> entities{};
 
-    registry.sort<Position>([](const auto &lhs, const auto &rhs) {
-        return lhs.x < rhs.x && lhs.y < rhs.y;
+    measure("Destroying 10000000 entities, two components, static registry", 10000000L, [&]() {
+        registry = StaticRegistry{};
+        entities.clear();
+
+        for(uint64_t i = 0; i < 10000000L; i++) {
+            entities.push_back(registry.create<Position, Velocity>());
+        }
+    }, [&]() {
+        for(auto entity: entities) {
+            registry.destroy(entity);
+        }
     });
+}
+
+TEST(Benchmark, StaticIterateSingleComponent10M) {
+    StaticRegistry registry;
 
-    Timer timer;
+    for(uint64_t i = 0; i < 10000000L; i++) {
+        registry.create<Position>();
+    }
 
-    registry.sort<Velocity, Position>();
+    measure("Iterating over 10000000 entities, one component, static registry", 10000000L, [&registry]() {
+        registry.view<Position>().each([](auto, auto &) {});
+    });
+}
+
+TEST(Benchmark, StaticIterateTwoComponents10M) {
+    StaticRegistry registry;
 
-    timer.elapsed();
+    for(uint64_t i = 0; i < 10000000L; i++) {
+        registry.create<Position, Velocity>();
+    }
+
+    measure("Iterating over 10000000 entities, two components, static registry", 10000000L, [&registry]() {
+        registry.view<Position, Velocity>().each([](auto, auto &...) {});
+    });
+}
+
+TEST(Benchmark, StaticIterateTwoComponentsPersistent10M) {
+    StaticRegistry registry;
+    registry.prepare<Position, Velocity>();
+
+    for(uint64_t i = 0; i < 10000000L; i++) {
+        registry.create<Position, Velocity>();
+    }
+
+    measure("Iterating over 10000000 entities, two components, persistent view, static registry", 10000000L, [&registry]() {
+        registry.persistent<Position, Velocity>().each([](auto, auto &...) {});
+    });
+}
+
+TEST(Benchmark, SystemGraph20Systems) {
+    entt::DefaultRegistry registry;
+    const auto concurrency = std::max(1u, std::thread::hardware_concurrency());
+
+    createEntities(registry, 1000000L, std::make_index_sequence<10>{});
+
+    for(auto threads = 1u; threads <= concurrency; threads *= 2) {
+        entt::SystemGraph<double> graph{threads};
+        attachSystems(graph, registry, std::make_index_sequence<10>{});
+
+        measure("Running 10 frames of a pipeline of 20 systems over 1000000 entities, " + std::to_string(threads) + " thread(s)", 10L * 1000000L, [&graph]() {
+            for(auto frame = 0; frame < 10; ++frame) {
+                graph.update(.1);
+            }
+        });
+    }
+}
+
+TEST(Benchmark, FootprintDense) {
+    measureFootprint("Memory of 1000000 entities, dense ids, one component", [](auto &registry) {
+        return createWith<Position>(registry, 1000000u);
+    });
+
+    measureFootprint("Memory of 1000000 entities, dense ids, two components", [](auto &registry) {
+        return createWith<Position, Velocity>(registry, 1000000u);
+    });
+
+    measureFootprint("Memory of 1000000 entities, dense ids, twenty tag components", [](auto &registry) {
+        return createWithTags(registry, 1000000u, std::make_index_sequence<20>{});
+    });
+}
+
+TEST(Benchmark, FootprintSparse) {
+    measureFootprint("Memory of 1000000 entities, sparse ids up to 10000000, one component", [](auto &registry) {
+        std::vector<entt::DefaultRegistry::entity_type> entities;
+
+        for(std::size_t i = 0; i < 10000000u; i++) {
+            const auto entity = registry.create();
+
+            if(i % 10) {
+                entities.push_back(entity);
+            } else {
+                registry.template assign<Position>(entity);
+            }
+        }
+
+        registry.destroy(entities.cbegin(), entities.cend());
+        entities.clear();
+        entities.shrink_to_fit();
+
+        return registry.size();
+    });
+}
+
+TEST(Benchmark, FootprintPersistent) {
+    measureFootprint("Memory of 1000000 entities, two components, persistent view", [](auto &registry) {
+        registry.template prepare<Position, Velocity>();
+        return createWith<Position, Velocity>(registry, 1000000u);
+    });
+
+    measureFootprint("Memory of 1000000 entities, five components, persistent view", [](auto &registry) {
+        registry.template prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>();
+        return createWith<Position, Velocity, Comp<1>, Comp<2>, Comp<3>>(registry, 1000000u);
+    });
+
+    measureFootprint("Memory of 1000000 entities, ten components, persistent view", [](auto &registry) {
+        registry.template prepare<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>();
+        return createWith<Position, Velocity, Comp<1>, Comp<2>, Comp<3>, Comp<4>, Comp<5>, Comp<6>, Comp<7>, Comp<8>>(registry, 1000000u);
+    });
+}
+
+TEST(Benchmark, FootprintMassDestroy) {
+    const auto populate = [](auto &registry) {
+        std::vector<entt::DefaultRegistry::entity_type> entities;
+
+        for(std::size_t i = 0; i < 1000000u; i++) {
+            const auto entity = registry.template create<Position, Velocity>();
+
+            if(i % 100) {
+                entities.push_back(entity);
+            }
+        }
+
+        registry.destroy(entities.cbegin(), entities.cend());
+    };
+
+    measureFootprint("Memory of 10000 entities out of 1000000 after a mass destroy, two components", [&populate](auto &registry) {
+        populate(registry);
+        return registry.size();
+    });
+
+    measureFootprint("Memory of 10000 entities out of 1000000 after a mass destroy and a shrink, two components", [&populate](auto &registry) {
+        populate(registry);
+        registry.shrink_to_fit();
+        return registry.size();
+    });
 }
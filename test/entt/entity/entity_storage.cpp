@@ -0,0 +1,71 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/entity_storage.hpp>
+
+TEST(EntityStorage, Functionalities) {
+    entt::EntityStorage<unsigned int> storage;
+
+    ASSERT_TRUE(storage.empty());
+    ASSERT_EQ(storage.size(), 0u);
+    ASSERT_EQ(storage.capacity(), 0u);
+    ASSERT_EQ(storage.available(), 0u);
+
+    const auto e0 = storage.create();
+    const auto e1 = storage.create();
+
+    ASSERT_FALSE(storage.empty());
+    ASSERT_EQ(storage.size(), 2u);
+    ASSERT_EQ(storage.capacity(), 2u);
+    ASSERT_TRUE(storage.valid(e0));
+    ASSERT_TRUE(storage.valid(e1));
+    ASSERT_EQ(storage.current(e0), 0u);
+
+    storage.release(e0);
+
+    ASSERT_FALSE(storage.valid(e0));
+    ASSERT_EQ(storage.size(), 1u);
+    ASSERT_EQ(storage.available(), 1u);
+    ASSERT_EQ(storage.current(e0), 1u);
+
+    const auto e2 = storage.create();
+
+    ASSERT_EQ(storage.capacity(), 2u);
+    ASSERT_EQ(storage.available(), 0u);
+    ASSERT_TRUE(storage.valid(e2));
+    ASSERT_EQ(e2 & entt::entt_traits<unsigned int>::entity_mask, e0);
+    ASSERT_EQ(storage.version(e2), 1u);
+}
+
+TEST(EntityStorage, ResetAndEach) {
+    entt::EntityStorage<unsigned int> storage;
+    std::vector<unsigned int> entities;
+
+    const auto e0 = storage.create();
+    const auto e1 = storage.create();
+    const auto e2 = storage.create();
+    storage.release(e1);
+
+    storage.each([&entities](auto entity) { entities.push_back(entity); });
+
+    ASSERT_EQ(entities.size(), 2u);
+    ASSERT_EQ(entities[0], e2);
+    ASSERT_EQ(entities[1], e0);
+
+    storage.reset();
+    entities.clear();
+    storage.each([&entities](auto entity) { entities.push_back(entity); });
+
+    ASSERT_TRUE(storage.empty());
+    ASSERT_TRUE(entities.empty());
+    ASSERT_EQ(storage.available(), 3u);
+    ASSERT_EQ(storage.current(e0), 1u);
+    ASSERT_EQ(storage.current(e1), 1u);
+    ASSERT_EQ(storage.current(e2), 1u);
+
+    storage.create();
+    storage.create();
+    storage.create();
+
+    ASSERT_EQ(storage.capacity(), 3u);
+    ASSERT_EQ(storage.size(), 3u);
+}
@@ -0,0 +1,185 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/hierarchy.hpp>
+#include <entt/entity/sparse_set.hpp>
+
+using Hierarchy = entt::Hierarchy<std::uint32_t>;
+
+void validate(const Hierarchy &hierarchy) {
+    std::vector<bool> visited;
+
+    hierarchy.each([&visited](auto entity, auto parent) {
+        if(!(entity < visited.size())) {
+            visited.resize(entity + 1, false);
+        }
+
+        ASSERT_TRUE(entity == parent || (parent < visited.size() && visited[parent]));
+        visited[entity] = true;
+    });
+}
+
+TEST(Hierarchy, Functionalities) {
+    Hierarchy hierarchy;
+
+    ASSERT_TRUE(hierarchy.empty());
+
+    hierarchy.construct(0);
+    hierarchy.construct(1, 0);
+    hierarchy.construct(2, 0);
+    hierarchy.construct(3, 1);
+
+    ASSERT_EQ(hierarchy.size(), Hierarchy::size_type{4});
+    ASSERT_EQ(hierarchy.parent(0), 0u);
+    ASSERT_EQ(hierarchy.parent(1), 0u);
+    ASSERT_EQ(hierarchy.parent(3), 1u);
+    ASSERT_EQ(hierarchy.children(0), Hierarchy::size_type{2});
+    ASSERT_EQ(hierarchy.children(1), Hierarchy::size_type{1});
+    ASSERT_EQ(hierarchy.children(3), Hierarchy::size_type{0});
+
+    validate(hierarchy);
+
+    hierarchy.destroy(1);
+
+    ASSERT_FALSE(hierarchy.has(1));
+    ASSERT_EQ(hierarchy.parent(3), 3u);
+    ASSERT_EQ(hierarchy.children(0), Hierarchy::size_type{1});
+
+    validate(hierarchy);
+
+    hierarchy.reset();
+
+    ASSERT_TRUE(hierarchy.empty());
+}
+
+TEST(Hierarchy, Reparent) {
+    Hierarchy hierarchy;
+
+    hierarchy.construct(0);
+    hierarchy.construct(1, 0);
+    hierarchy.construct(2, 1);
+    hierarchy.construct(3);
+    hierarchy.construct(4, 3);
+    hierarchy.construct(5, 2);
+
+    // the new parent follows the subtree of the entity
+    hierarchy.reparent(1, 4);
+
+    ASSERT_EQ(hierarchy.parent(1), 4u);
+    ASSERT_EQ(hierarchy.children(0), Hierarchy::size_type{0});
+    ASSERT_EQ(hierarchy.children(4), Hierarchy::size_type{1});
+
+    validate(hierarchy);
+
+    // the new parent already precedes the entity
+    hierarchy.reparent(5, 0);
+
+    ASSERT_EQ(hierarchy.parent(5), 0u);
+    ASSERT_EQ(hierarchy.children(2), Hierarchy::size_type{0});
+
+    validate(hierarchy);
+
+    hierarchy.reparent(1, 1);
+
+    ASSERT_EQ(hierarchy.parent(1), 1u);
+    ASSERT_EQ(hierarchy.children(4), Hierarchy::size_type{0});
+
+    validate(hierarchy);
+}
+
+TEST(Hierarchy, Destroy) {
+    Hierarchy hierarchy;
+
+    hierarchy.construct(0);
+    hierarchy.construct(1);
+    hierarchy.construct(2, 0);
+    hierarchy.construct(3, 2);
+    hierarchy.construct(4, 1);
+
+    // the last element can't take the place of the entity
+    hierarchy.destroy(0);
+
+    ASSERT_EQ(hierarchy.parent(2), 2u);
+    ASSERT_EQ(hierarchy.parent(3), 2u);
+    ASSERT_EQ(hierarchy.parent(4), 1u);
+
+    validate(hierarchy);
+
+    hierarchy.destroy(3);
+    hierarchy.destroy(1);
+
+    ASSERT_EQ(hierarchy.size(), Hierarchy::size_type{2});
+    ASSERT_EQ(hierarchy.parent(4), 4u);
+
+    validate(hierarchy);
+}
+
+TEST(Hierarchy, Respect) {
+    Hierarchy hierarchy;
+    entt::SparseSet<std::uint32_t, int> set;
+
+    set.construct(2, 2);
+    set.construct(0, 0);
+    set.construct(1, 1);
+
+    hierarchy.construct(0);
+    hierarchy.construct(1, 0);
+    hierarchy.construct(2, 1);
+
+    set.respect(hierarchy);
+
+    // iterators return children first
+    auto it = set.begin();
+
+    ASSERT_EQ(*(it++), 2u);
+    ASSERT_EQ(*(it++), 1u);
+    ASSERT_EQ(*(it++), 0u);
+    ASSERT_EQ(set.raw()[0], 0);
+    ASSERT_EQ(set.raw()[2], 2);
+}
+
+TEST(Hierarchy, Random) {
+    Hierarchy hierarchy;
+    std::vector<std::uint32_t> entities;
+    std::uint32_t next = 0;
+    unsigned int seed = 42u;
+
+    auto random = [&seed](std::size_t max) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) % max;
+    };
+
+    for(auto i = 0; i < 2000; ++i) {
+        const auto op = random(4);
+
+        if(entities.empty() || op == 0) {
+            hierarchy.construct(next);
+            entities.push_back(next++);
+        } else if(op == 1) {
+            hierarchy.construct(next, entities[random(entities.size())]);
+            entities.push_back(next++);
+        } else if(op == 2) {
+            const auto pos = random(entities.size());
+            hierarchy.destroy(entities[pos]);
+            entities.erase(entities.begin() + pos);
+        } else {
+            const auto entity = entities[random(entities.size())];
+            auto parent = entities[random(entities.size())];
+            auto curr = parent;
+
+            while(curr != entity && hierarchy.parent(curr) != curr) {
+                curr = hierarchy.parent(curr);
+            }
+
+            // an entity can't be attached to its own subtree
+            hierarchy.reparent(entity, curr == entity ? entity : parent);
+        }
+
+        validate(hierarchy);
+
+        if(::testing::Test::HasFatalFailure()) {
+            FAIL();
+        }
+    }
+
+    ASSERT_EQ(hierarchy.size(), entities.size());
+}
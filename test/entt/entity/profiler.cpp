@@ -0,0 +1,114 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <entt/entity/profiler.hpp>
+#include <entt/entity/registry.hpp>
+
+struct Position {
+    int x;
+    int y;
+};
+
+struct Velocity {
+    int dx;
+    int dy;
+};
+
+std::size_t count(const std::string &name, entt::ProfileEvent event) {
+    std::size_t result = 0;
+
+    entt::Profiler::instance().each([&](const auto &other, auto type, auto cnt, auto) {
+        if(other.find(name) != std::string::npos && type == event) {
+            result += cnt;
+        }
+    });
+
+    return result;
+}
+
+TEST(Profiler, Counters) {
+    auto &profiler = entt::Profiler::instance();
+    entt::DefaultRegistry registry;
+
+    // persistent views iterate a standard view when they are initialized
+    registry.prepare<Position, Velocity>();
+    profiler.reset();
+
+    const auto entity = registry.create<Position, Velocity>();
+    registry.create<Position>();
+    registry.remove<Velocity>(entity);
+    registry.sort<Position>([](const auto &lhs, const auto &rhs) { return lhs.x < rhs.x; });
+    registry.view<Position>().each([](auto, auto &) {});
+    registry.persistent<Position, Velocity>().each([](auto, auto &, auto &) {});
+    registry.destroy(entity);
+
+    ASSERT_EQ(count("Registry", entt::ProfileEvent::CREATE), 2u);
+    ASSERT_EQ(count("Registry", entt::ProfileEvent::DESTROY), 1u);
+    ASSERT_EQ(count("Position", entt::ProfileEvent::ASSIGN), 2u);
+    ASSERT_EQ(count("Velocity", entt::ProfileEvent::ASSIGN), 1u);
+    ASSERT_EQ(count("Velocity", entt::ProfileEvent::REMOVE), 1u);
+    ASSERT_EQ(count("Position", entt::ProfileEvent::SORT), 1u);
+    ASSERT_EQ(count("View", entt::ProfileEvent::VIEW), 2u);
+    ASSERT_EQ(count("View", entt::ProfileEvent::EACH), 2u);
+
+    profiler.reset();
+
+    ASSERT_EQ(count("Registry", entt::ProfileEvent::CREATE), 0u);
+}
+
+TEST(Profiler, Threads) {
+    auto &profiler = entt::Profiler::instance();
+    profiler.reset();
+
+    auto work = []() {
+        entt::DefaultRegistry registry;
+
+        for(auto i = 0; i < 100; ++i) {
+            registry.create<Position>();
+        }
+    };
+
+    std::thread first{work};
+    std::thread second{work};
+    work();
+    first.join();
+    second.join();
+
+    ASSERT_EQ(count("Registry", entt::ProfileEvent::CREATE), 300u);
+    ASSERT_EQ(count("Position", entt::ProfileEvent::ASSIGN), 300u);
+
+    profiler.reset();
+}
+
+TEST(Profiler, Trace) {
+    auto &profiler = entt::Profiler::instance();
+    entt::DefaultRegistry registry;
+    std::ostringstream untimed;
+    std::ostringstream timed;
+
+    profiler.reset();
+    registry.create<Position>();
+    profiler.trace(untimed);
+
+    ASSERT_FALSE(profiler.timing());
+    ASSERT_EQ(untimed.str(), "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}");
+
+    profiler.timing(true);
+    registry.create<Position>();
+    registry.view<Position>().each([](auto, auto &) {});
+    profiler.timing(false);
+    profiler.trace(timed);
+
+    const auto trace = timed.str();
+
+    ASSERT_TRUE(profiler.timing() == false);
+    ASSERT_EQ(trace.find("{\"traceEvents\":[{"), 0u);
+    ASSERT_NE(trace.find("\"cat\":\"create\""), std::string::npos);
+    ASSERT_NE(trace.find("\"cat\":\"assign\""), std::string::npos);
+    ASSERT_NE(trace.find("\"cat\":\"each\""), std::string::npos);
+    ASSERT_NE(trace.find("\"name\":\"Position\""), std::string::npos);
+    ASSERT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+
+    profiler.reset();
+}
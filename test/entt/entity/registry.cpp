@@ -1,4 +1,9 @@
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <entt/entity/registry.hpp>
 
@@ -134,6 +139,568 @@ TEST(DefaultRegistry, CreateDestroyEntities) {
     ASSERT_EQ(registry.current(pre), registry.current(post));
 }
 
+TEST(DefaultRegistry, DestroyRange) {
+    entt::DefaultRegistry registry;
+    registry.prepare<int, char>();
+
+    const auto e0 = registry.create<int, char>();
+    const auto e1 = registry.create<int>();
+    const auto e2 = registry.create<int, char>();
+    const auto e3 = registry.create<double>();
+
+    const std::vector<entt::DefaultRegistry::entity_type> range{e2, e0, e3};
+    registry.destroy(range.cbegin(), range.cend());
+
+    ASSERT_FALSE(registry.valid(e0));
+    ASSERT_TRUE(registry.valid(e1));
+    ASSERT_FALSE(registry.valid(e2));
+    ASSERT_FALSE(registry.valid(e3));
+
+    ASSERT_EQ(registry.size(), entt::DefaultRegistry::size_type{1});
+    ASSERT_EQ(registry.size<int>(), entt::DefaultRegistry::size_type{1});
+    ASSERT_TRUE(registry.empty<char>());
+    ASSERT_TRUE(registry.empty<double>());
+    ASSERT_EQ((registry.persistent<int, char>().size()), entt::DefaultRegistry::size_type{0});
+
+    // the last entity destroyed is the first one recycled
+    ASSERT_EQ(registry.create() & entt::entt_traits<entt::DefaultRegistry::entity_type>::entity_mask, e3 & entt::entt_traits<entt::DefaultRegistry::entity_type>::entity_mask);
+}
+
+TEST(DefaultRegistry, RecycleEntities) {
+    entt::DefaultRegistry registry;
+
+    auto e1 = registry.create();
+    auto e2 = registry.create();
+    auto e3 = registry.create();
+
+    registry.destroy(e1);
+    registry.destroy(e3);
+
+    ASSERT_EQ(registry.size(), entt::DefaultRegistry::size_type{1});
+    ASSERT_EQ(registry.capacity(), entt::DefaultRegistry::size_type{3});
+
+    auto e4 = registry.create();
+    auto e5 = registry.create();
+    auto e6 = registry.create();
+
+    ASSERT_EQ(registry.capacity(), entt::DefaultRegistry::size_type{4});
+    ASSERT_TRUE(registry.valid(e2));
+    ASSERT_TRUE(registry.valid(e4));
+    ASSERT_TRUE(registry.valid(e5));
+    ASSERT_TRUE(registry.valid(e6));
+    ASSERT_FALSE(registry.valid(e1));
+    ASSERT_FALSE(registry.valid(e3));
+    ASSERT_EQ(registry.current(e4), entt::DefaultRegistry::version_type{1});
+    ASSERT_EQ(registry.current(e5), entt::DefaultRegistry::version_type{1});
+    ASSERT_EQ(registry.version(e6), entt::DefaultRegistry::version_type{0});
+
+    registry.reset();
+
+    ASSERT_TRUE(registry.empty());
+    ASSERT_FALSE(registry.valid(e2));
+    ASSERT_EQ(registry.current(e2), entt::DefaultRegistry::version_type{1});
+    ASSERT_EQ(registry.current(e4), entt::DefaultRegistry::version_type{2});
+
+    for(auto i = 0; i < 4; ++i) {
+        ASSERT_TRUE(registry.valid(registry.create()));
+    }
+
+    ASSERT_EQ(registry.size(), entt::DefaultRegistry::size_type{4});
+    ASSERT_EQ(registry.capacity(), entt::DefaultRegistry::size_type{4});
+}
+
+TEST(DefaultRegistry, Each) {
+    entt::DefaultRegistry registry;
+    entt::DefaultRegistry::size_type tot;
+    entt::DefaultRegistry::size_type match;
+
+    registry.create();
+    registry.create<int>();
+    registry.create();
+    registry.create<int>();
+    registry.create();
+
+    tot = 0u;
+    match = 0u;
+
+    registry.each([&](auto entity) {
+        if(registry.has<int>(entity)) { ++match; }
+        registry.create();
+        ++tot;
+    });
+
+    ASSERT_EQ(tot, 5u);
+    ASSERT_EQ(match, 2u);
+
+    tot = 0u;
+    match = 0u;
+
+    registry.each([&](auto entity) {
+        if(registry.has<int>(entity)) {
+            registry.destroy(entity);
+            ++match;
+        }
+
+        ++tot;
+    });
+
+    ASSERT_EQ(tot, 10u);
+    ASSERT_EQ(match, 2u);
+
+    tot = 0u;
+    match = 0u;
+
+    registry.each([&](auto entity) {
+        if(registry.has<int>(entity)) { ++match; }
+        registry.destroy(entity);
+        ++tot;
+    });
+
+    ASSERT_EQ(tot, 8u);
+    ASSERT_EQ(match, 0u);
+
+    registry.each([&](auto) { FAIL(); });
+}
+
+TEST(DefaultRegistry, Context) {
+    entt::DefaultRegistry registry;
+
+    ASSERT_EQ(registry.try_ctx<int>(), nullptr);
+    ASSERT_EQ(registry.try_ctx<double>(), nullptr);
+
+    ASSERT_EQ(registry.set<int>(42), 42);
+    ASSERT_EQ(registry.set<double>(3.), 3.);
+
+    ASSERT_NE(registry.try_ctx<int>(), nullptr);
+    ASSERT_NE(registry.try_ctx<double>(), nullptr);
+    ASSERT_EQ(registry.ctx<int>(), 42);
+    ASSERT_EQ(static_cast<const entt::DefaultRegistry &>(registry).ctx<double>(), 3.);
+
+    registry.ctx<int>() = 0;
+    registry.create<int>();
+    registry.reset();
+
+    ASSERT_EQ(registry.size<int>(), entt::DefaultRegistry::size_type{0});
+    ASSERT_EQ(registry.ctx<int>(), 0);
+    ASSERT_EQ(registry.set<int>(1), 1);
+    ASSERT_EQ(registry.ctx<int>(), 1);
+
+    registry.unset<int>();
+    registry.unset<char>();
+
+    ASSERT_EQ(registry.try_ctx<int>(), nullptr);
+    ASSERT_EQ(registry.try_ctx<char>(), nullptr);
+    ASSERT_NE(registry.try_ctx<double>(), nullptr);
+}
+
+TEST(DefaultRegistry, Clone) {
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    registry.prepare<int, char>();
+
+    auto prototype = registry.create<int, char>(42, 'c');
+    registry.assign<std::unique_ptr<int>>(prototype);
+    registry.create<int>(0);
+
+    registry.clone(prototype, 10, std::back_inserter(entities));
+
+    ASSERT_EQ(entities.size(), decltype(entities)::size_type{10});
+    ASSERT_EQ(registry.size(), entt::DefaultRegistry::size_type{12});
+    ASSERT_EQ(registry.size<int>(), entt::DefaultRegistry::size_type{12});
+    ASSERT_EQ(registry.size<char>(), entt::DefaultRegistry::size_type{11});
+    ASSERT_EQ(registry.size<std::unique_ptr<int>>(), entt::DefaultRegistry::size_type{1});
+    ASSERT_EQ((registry.persistent<int, char>().size()), entt::DefaultRegistry::size_type{11});
+
+    for(auto entity: entities) {
+        ASSERT_TRUE(registry.valid(entity));
+        ASSERT_TRUE((registry.has<int, char>(entity)));
+        ASSERT_FALSE(registry.has<std::unique_ptr<int>>(entity));
+        ASSERT_EQ(registry.get<int>(entity), 42);
+        ASSERT_EQ(registry.get<char>(entity), 'c');
+    }
+
+    entt::DefaultRegistry other;
+    entities.clear();
+
+    other.create<double>(.3);
+    other.clone(registry, prototype, 3, std::back_inserter(entities));
+
+    ASSERT_EQ(entities.size(), decltype(entities)::size_type{3});
+    ASSERT_EQ(other.size(), entt::DefaultRegistry::size_type{4});
+    ASSERT_EQ(other.size<int>(), entt::DefaultRegistry::size_type{3});
+    ASSERT_EQ(other.size<char>(), entt::DefaultRegistry::size_type{3});
+    ASSERT_EQ(other.size<double>(), entt::DefaultRegistry::size_type{1});
+
+    for(auto entity: entities) {
+        ASSERT_EQ(other.get<int>(entity), 42);
+        ASSERT_EQ(other.get<char>(entity), 'c');
+    }
+
+    entities.clear();
+    other.clone(prototype, 0, std::back_inserter(entities));
+
+    ASSERT_TRUE(entities.empty());
+    ASSERT_EQ(other.size(), entt::DefaultRegistry::size_type{4});
+}
+
+TEST(DefaultRegistry, Transfer) {
+    entt::DefaultRegistry registry;
+    entt::DefaultRegistry other;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    other.prepare<int, char>();
+
+    const auto e1 = registry.create<int, char>(42, 'c');
+    const auto e2 = registry.create<int>(3);
+    const auto e3 = registry.create<char>('a');
+    registry.assign<std::unique_ptr<int>>(e2, std::make_unique<int>(99));
+
+    const std::vector<entt::DefaultRegistry::entity_type> source{e1, e2};
+    other.create<double>();
+    other.transfer(registry, source.cbegin(), source.cend(), std::back_inserter(entities));
+
+    ASSERT_EQ(entities.size(), decltype(entities)::size_type{2});
+    ASSERT_FALSE(registry.valid(e1));
+    ASSERT_FALSE(registry.valid(e2));
+    ASSERT_TRUE(registry.valid(e3));
+    ASSERT_EQ(registry.size(), entt::DefaultRegistry::size_type{1});
+    ASSERT_EQ(registry.size<int>(), entt::DefaultRegistry::size_type{0});
+    ASSERT_EQ(registry.size<char>(), entt::DefaultRegistry::size_type{1});
+    ASSERT_EQ(registry.size<std::unique_ptr<int>>(), entt::DefaultRegistry::size_type{0});
+
+    ASSERT_EQ(other.size(), entt::DefaultRegistry::size_type{3});
+    ASSERT_TRUE((other.has<int, char>(entities[0])));
+    ASSERT_EQ(other.get<int>(entities[0]), 42);
+    ASSERT_EQ(other.get<char>(entities[0]), 'c');
+    ASSERT_TRUE((other.has<int, std::unique_ptr<int>>(entities[1])));
+    ASSERT_FALSE(other.has<char>(entities[1]));
+    ASSERT_EQ(other.get<int>(entities[1]), 3);
+    ASSERT_EQ(*other.get<std::unique_ptr<int>>(entities[1]), 99);
+    ASSERT_EQ((other.persistent<int, char>().size()), entt::DefaultRegistry::size_type{1});
+
+    const auto e4 = registry.transfer(other, entities[0]);
+
+    ASSERT_FALSE(other.valid(entities[0]));
+    ASSERT_TRUE(registry.valid(e4));
+    ASSERT_EQ(registry.get<int>(e4), 42);
+    ASSERT_EQ(registry.get<char>(e4), 'c');
+    ASSERT_EQ((other.persistent<int, char>().size()), entt::DefaultRegistry::size_type{0});
+}
+
+TEST(DefaultRegistry, Index) {
+    struct NetworkId { unsigned int value; };
+    entt::DefaultRegistry registry;
+
+    const auto e0 = registry.create<NetworkId>(NetworkId{3u});
+    const auto e1 = registry.create<NetworkId>(NetworkId{7u});
+
+    registry.index<NetworkId>([](const auto &id) { return id.value; });
+
+    ASSERT_NE(registry.lookup<NetworkId>(3u), nullptr);
+    ASSERT_EQ(*registry.lookup<NetworkId>(3u), e0);
+    ASSERT_EQ(*registry.lookup<NetworkId>(7u), e1);
+    ASSERT_EQ(registry.lookup<NetworkId>(42u), nullptr);
+
+    const auto e2 = registry.create();
+    registry.assign<NetworkId>(e2, 42u);
+
+    ASSERT_EQ(*registry.lookup<NetworkId>(42u), e2);
+
+    registry.replace<NetworkId>(e0, 5u);
+
+    ASSERT_EQ(registry.lookup<NetworkId>(3u), nullptr);
+    ASSERT_EQ(*registry.lookup<NetworkId>(5u), e0);
+
+    registry.accomodate<NetworkId>(e0, 4u);
+
+    ASSERT_EQ(registry.lookup<NetworkId>(5u), nullptr);
+    ASSERT_EQ(*registry.lookup<NetworkId>(4u), e0);
+
+    registry.remove<NetworkId>(e1);
+    registry.destroy(e2);
+
+    ASSERT_EQ(registry.lookup<NetworkId>(7u), nullptr);
+    ASSERT_EQ(registry.lookup<NetworkId>(42u), nullptr);
+    ASSERT_EQ(*registry.lookup<NetworkId>(4u), e0);
+
+    entt::DefaultRegistry other;
+    other.index<NetworkId>([](const auto &id) { return id.value; });
+    const auto e3 = other.transfer(registry, e0);
+
+    ASSERT_EQ(registry.lookup<NetworkId>(4u), nullptr);
+    ASSERT_EQ(*other.lookup<NetworkId>(4u), e3);
+}
+
+TEST(DefaultRegistry, IndexTransfer) {
+    struct Name { std::string value; };
+    const std::string name{"a rather long name that doesn't fit a small buffer"};
+    const std::string other_name{"short"};
+    entt::DefaultRegistry registry;
+    entt::DefaultRegistry other;
+
+    registry.index<Name>([](const auto &name) { return name.value; });
+    other.index<Name>([](const auto &name) { return name.value; });
+
+    const auto e0 = registry.create<Name>(Name{name});
+    const auto e1 = registry.create<Name>(Name{other_name});
+    const std::vector<entt::DefaultRegistry::entity_type> source{e0, e1};
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    other.transfer(registry, source.cbegin(), source.cend(), std::back_inserter(entities));
+
+    ASSERT_EQ(registry.lookup<Name>(name), nullptr);
+    ASSERT_EQ(registry.lookup<Name>(other_name), nullptr);
+    ASSERT_EQ(*other.lookup<Name>(name), entities[0]);
+    ASSERT_EQ(*other.lookup<Name>(other_name), entities[1]);
+    ASSERT_EQ(other.get<Name>(entities[1]).value, other_name);
+
+    const auto e2 = registry.create<Name>(Name{other_name});
+
+    ASSERT_EQ(*registry.lookup<Name>(other_name), e2);
+}
+
+TEST(DefaultRegistry, Grid) {
+    struct Point { float x; float y; };
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    const auto e0 = registry.create<Point>(Point{0.f, 0.f});
+    const auto e1 = registry.create<Point>(Point{3.f, 3.f});
+
+    registry.grid<Point>(2.f, [](const auto &point) { return std::make_pair(point.x, point.y); });
+    registry.query<Point>(0.f, 0.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{e0}));
+
+    const auto e2 = registry.create<Point>(Point{.5f, .5f});
+    registry.replace<Point>(e0, 10.f, 10.f);
+    registry.accomodate<Point>(e1, 0.f, 1.f);
+
+    entities.clear();
+    registry.query<Point>(-1.f, -1.f, 1.f, 1.f, std::back_inserter(entities));
+    std::sort(entities.begin(), entities.end());
+
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{e1, e2}));
+
+    registry.remove<Point>(e1);
+    registry.destroy(e2);
+
+    entities.clear();
+    registry.query<Point>(-1.f, -1.f, 1.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_TRUE(entities.empty());
+
+    entities.clear();
+    registry.query<Point>(10.f, 10.f, 0.f, std::back_inserter(entities));
+
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{e0}));
+}
+
+TEST(DefaultRegistry, ShrinkToFitKeepsPolicy) {
+    entt::DefaultRegistry registry;
+    registry.policy<int>(entt::DeletionPolicy::TOMBSTONE);
+
+    const auto entity = registry.create<int>(42);
+    registry.remove<int>(entity);
+    registry.shrink_to_fit();
+
+    ASSERT_EQ(registry.policy<int>(), entt::DeletionPolicy::TOMBSTONE);
+
+    registry.assign<int>(entity, 3);
+    registry.remove<int>(entity);
+
+    ASSERT_EQ(registry.policy<int>(), entt::DeletionPolicy::TOMBSTONE);
+    ASSERT_EQ(registry.size<int>(), 0u);
+    ASSERT_EQ(registry.view<int>().length(), 1u);
+}
+
+TEST(DefaultRegistry, ResetKeepsPools) {
+    struct Body { unsigned int id; float x; float y; };
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    registry.index<Body>([](const auto &body) { return body.id; });
+    registry.grid<Body>(2.f, [](const auto &body) { return std::make_pair(body.x, body.y); });
+    registry.policy<int>(entt::DeletionPolicy::TOMBSTONE);
+    registry.prepare<int, char>();
+
+    registry.create<Body>(Body{3u, 0.f, 0.f});
+    registry.create<int, char>();
+    registry.reset();
+
+    registry.query<Body>(0.f, 0.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_TRUE(entities.empty());
+    ASSERT_EQ(registry.lookup<Body>(3u), nullptr);
+    ASSERT_EQ(registry.policy<int>(), entt::DeletionPolicy::TOMBSTONE);
+    ASSERT_EQ((registry.persistent<int, char>().size()), 0u);
+
+    const auto entity = registry.create<Body>(Body{3u, .5f, .5f});
+    registry.assign<int>(entity);
+    registry.assign<char>(entity);
+    registry.query<Body>(0.f, 0.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_EQ(*registry.lookup<Body>(3u), entity);
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{entity}));
+    ASSERT_EQ((registry.persistent<int, char>().size()), 1u);
+}
+
+TEST(DefaultRegistry, IndexAndGrid) {
+    struct Unit { unsigned int id; float x; float y; };
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    registry.index<Unit>([](const auto &unit) { return unit.id; });
+    registry.grid<Unit>(2.f, [](const auto &unit) { return std::make_pair(unit.x, unit.y); });
+
+    const auto e0 = registry.create<Unit>(Unit{3u, 0.f, 0.f});
+    const auto e1 = registry.create<Unit>(Unit{7u, 5.f, 5.f});
+
+    ASSERT_EQ(*registry.lookup<Unit>(3u), e0);
+    ASSERT_EQ(*registry.lookup<Unit>(7u), e1);
+
+    registry.query<Unit>(0.f, 0.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{e0}));
+
+    registry.replace<Unit>(e1, 8u, .5f, .5f);
+    registry.destroy(e0);
+
+    entities.clear();
+    registry.query<Unit>(0.f, 0.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_EQ(registry.lookup<Unit>(3u), nullptr);
+    ASSERT_EQ(registry.lookup<Unit>(7u), nullptr);
+    ASSERT_EQ(*registry.lookup<Unit>(8u), e1);
+    ASSERT_EQ(entities, (std::vector<entt::DefaultRegistry::entity_type>{e1}));
+}
+
+TEST(DefaultRegistry, Tombstone) {
+    entt::DefaultRegistry registry;
+    registry.policy<int>(entt::DeletionPolicy::TOMBSTONE);
+
+    for(auto i = 0; i < 10; ++i) {
+        registry.assign<int>(registry.create(), i);
+    }
+
+    int visited = 0;
+
+    registry.view<int>().each([&registry, &visited](auto entity, auto &value) {
+        // removes also entities that haven't been visited yet
+        registry.remove<int>(entity);
+        ++visited;
+
+        if(value % 2) {
+            registry.view<int>().each([&registry](auto other, const auto &next) {
+                if(next == 0) {
+                    registry.remove<int>(other);
+                }
+            });
+        }
+    });
+
+    ASSERT_EQ(visited, 9);
+    ASSERT_EQ(registry.size<int>(), 0u);
+    ASSERT_TRUE(registry.empty<int>());
+    ASSERT_EQ(registry.view<int>().size(), 0u);
+    ASSERT_EQ(registry.view<int>().length(), 10u);
+
+    registry.compact();
+
+    ASSERT_EQ(registry.view<int>().size(), 0u);
+    ASSERT_EQ(registry.view<int>().length(), 0u);
+
+    const auto entity = registry.create();
+    registry.assign<int>(entity, 42);
+    registry.assign<char>(entity, 'c');
+    registry.compact<int>();
+    registry.compact<double>();
+
+    ASSERT_EQ(registry.size<int>(), 1u);
+    ASSERT_EQ(registry.get<int>(entity), 42);
+}
+
+TEST(DefaultRegistry, ShrinkToFit) {
+    entt::DefaultRegistry registry;
+    std::vector<entt::DefaultRegistry::entity_type> entities;
+
+    registry.reserve<int>(100);
+    registry.prepare<int, char>();
+
+    for(auto i = 0; i < 100; ++i) {
+        const auto entity = registry.create<int, char>();
+        registry.assign<double>(entity);
+        entities.push_back(entity);
+    }
+
+    const auto entity = registry.create<int>(42);
+    registry.destroy(entities.cbegin(), entities.cend());
+    registry.shrink_to_fit<int>();
+    registry.shrink_to_fit();
+
+    ASSERT_TRUE(registry.empty<double>());
+    ASSERT_EQ(registry.size<int>(), 1u);
+    ASSERT_EQ(registry.get<int>(entity), 42);
+    ASSERT_EQ((registry.persistent<int, char>().size()), 0u);
+
+    registry.assign<char>(entity, 'c');
+    registry.assign<double>(entity, .3);
+
+    ASSERT_EQ((registry.persistent<int, char>().size()), 1u);
+    ASSERT_EQ(registry.view<double>().size(), 1u);
+    ASSERT_EQ(registry.get<double>(entity), .3);
+}
+
+TEST(DefaultRegistry, Stats) {
+    entt::DefaultRegistry registry;
+    auto stats = registry.stats();
+
+    ASSERT_EQ(stats.entities, 0u);
+    ASSERT_EQ(stats.pools, 0u);
+    ASSERT_EQ(stats.bytes(), 0u);
+    ASSERT_EQ(registry.stats<int>().bytes(), 0u);
+
+    registry.reserve<int>(10);
+    registry.prepare<int, char>();
+
+    const auto entity = registry.create<int, char>();
+    registry.destroy(registry.create<int>());
+    stats = registry.stats();
+
+    ASSERT_EQ(stats.entities, 2u);
+    ASSERT_EQ(stats.available, 1u);
+    ASSERT_EQ(stats.pools, 2u);
+    ASSERT_EQ(stats.handlers, 1u);
+    ASSERT_EQ(registry.stats<int>().size, 1u);
+    ASSERT_EQ(registry.stats<int>().capacity, 10u);
+    ASSERT_EQ(registry.stats<int>().instances, 10u * sizeof(int));
+    ASSERT_EQ(stats.components, registry.stats<int>().bytes() + registry.stats<char>().bytes());
+    ASSERT_EQ(stats.views, (registry.persistent<int, char>().stats().bytes()));
+    ASSERT_EQ(stats.bytes(), stats.base + stats.components + stats.views);
+
+    entt::DefaultRegistry::size_type visited = 0;
+
+    registry.stats([&visited](auto type, const auto &pool) {
+        ASSERT_TRUE(type == entt::TypeHash<int>::value() || type == entt::TypeHash<char>::value());
+        ASSERT_EQ(pool.size, 1u);
+        ++visited;
+    });
+
+    ASSERT_EQ(visited, 2u);
+
+    registry.assign<double>(entity);
+
+    ASSERT_EQ(registry.stats().pools, 3u);
+
+    registry.destroy(entity);
+    registry.shrink_to_fit();
+
+    // the pool of doubles is released, the others are used by a persistent view
+    ASSERT_EQ(registry.stats().pools, 2u);
+    ASSERT_EQ(registry.stats<int>().instances, 0u);
+}
+
 TEST(DefaultRegistry, SortSingle) {
     entt::DefaultRegistry registry;
 
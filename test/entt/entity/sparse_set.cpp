@@ -1,3 +1,4 @@
+#include <functional>
 #include <gtest/gtest.h>
 #include <entt/entity/sparse_set.hpp>
 
@@ -70,6 +71,106 @@ TEST(SparseSetNoType, DataBeginEnd) {
     ASSERT_EQ(begin, end);
 }
 
+TEST(SparseSetNoType, Tombstone) {
+    entt::SparseSet<unsigned int> set;
+    const auto tombstone = entt::SparseSet<unsigned int>::entity_type{entt::SparseSet<unsigned int>::tombstone};
+
+    set.policy(entt::DeletionPolicy::TOMBSTONE);
+
+    ASSERT_EQ(set.policy(), entt::DeletionPolicy::TOMBSTONE);
+
+    set.construct(3);
+    set.construct(12);
+    set.construct(42);
+
+    for(auto entity: set) {
+        // removing other entities during an iteration is allowed
+        if(entity == 42u) {
+            set.destroy(12);
+        }
+    }
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_EQ(set.length(), 3u);
+    ASSERT_EQ(set.tombstones(), 1u);
+    ASSERT_FALSE(set.has(12));
+    ASSERT_EQ(set.get(3), 0u);
+    ASSERT_EQ(set.get(42), 2u);
+    ASSERT_EQ(*(set.data() + 1u), tombstone);
+
+    auto begin = set.begin();
+    auto end = set.end();
+
+    ASSERT_EQ(*(begin++), 42u);
+    ASSERT_EQ(*(begin++), 3u);
+    ASSERT_EQ(begin, end);
+
+    set.destroy(42);
+    set.destroy(3);
+
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.size(), 0u);
+    ASSERT_EQ(set.length(), 3u);
+    ASSERT_EQ(set.tombstones(), 3u);
+    ASSERT_EQ(set.begin(), set.end());
+
+    set.construct(12);
+    set.compact();
+
+    ASSERT_EQ(set.size(), 1u);
+    ASSERT_EQ(set.tombstones(), 0u);
+    ASSERT_EQ(set.get(12), 0u);
+
+    set.destroy(12);
+    set.construct(3);
+    set.policy(entt::DeletionPolicy::SWAP_AND_POP);
+
+    ASSERT_EQ(set.policy(), entt::DeletionPolicy::SWAP_AND_POP);
+    ASSERT_EQ(set.size(), 1u);
+    ASSERT_EQ(set.tombstones(), 0u);
+    ASSERT_EQ(set.get(3), 0u);
+
+    set.destroy(3);
+
+    ASSERT_TRUE(set.empty());
+}
+
+TEST(SparseSetNoType, ShrinkToFit) {
+    entt::SparseSet<unsigned int> set;
+
+    set.construct(3);
+    set.construct(12);
+    set.construct(42);
+    set.destroy(42);
+    set.shrink_to_fit();
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_TRUE(set.has(3));
+    ASSERT_TRUE(set.has(12));
+    ASSERT_FALSE(set.has(42));
+    ASSERT_EQ(set.get(3), 0u);
+    ASSERT_EQ(set.get(12), 1u);
+
+    set.policy(entt::DeletionPolicy::TOMBSTONE);
+    set.destroy(3);
+    set.shrink_to_fit();
+
+    ASSERT_EQ(set.size(), 1u);
+    ASSERT_EQ(set.tombstones(), 0u);
+    ASSERT_EQ(set.get(12), 0u);
+
+    set.destroy(12);
+    set.shrink_to_fit();
+
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.has(12));
+
+    set.construct(42);
+
+    ASSERT_TRUE(set.has(42));
+    ASSERT_EQ(set.get(42), 0u);
+}
+
 TEST(SparseSetWithType, AggregatesMustWork) {
     struct AggregateType { int value; };
     // the goal of this test is to enforce the requirements for aggregate types
@@ -144,6 +245,104 @@ TEST(SparseSetWithType, RawBeginEnd) {
     ASSERT_EQ(begin, end);
 }
 
+TEST(SparseSetWithType, Tombstone) {
+    entt::SparseSet<unsigned int, int> set;
+    set.policy(entt::DeletionPolicy::TOMBSTONE);
+
+    set.construct(3, 3);
+    set.construct(12, 6);
+    set.construct(42, 9);
+
+    const int *addr = &set.get(42);
+
+    set.destroy(3);
+    set.destroy(12);
+
+    ASSERT_EQ(&set.get(42), addr);
+    ASSERT_EQ(set.size(), 1u);
+    ASSERT_EQ(set.length(), 3u);
+    ASSERT_EQ(set.tombstones(), 2u);
+
+    set.construct(7, 12);
+    set.compact();
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_EQ(set.tombstones(), 0u);
+    ASSERT_EQ(*(set.raw() + 0u), 9);
+    ASSERT_EQ(*(set.raw() + 1u), 12);
+    ASSERT_EQ(set.get(42), 9);
+    ASSERT_EQ(set.get(7), 12);
+
+    set.destroy(42);
+    set.construct(1, 3);
+    set.sort(std::less<unsigned int>{});
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_EQ(set.tombstones(), 0u);
+
+    auto begin = set.begin();
+    auto end = set.end();
+
+    ASSERT_EQ(*(begin++), 1u);
+    ASSERT_EQ(*(begin++), 7u);
+    ASSERT_EQ(begin, end);
+    ASSERT_EQ(set.get(1), 3);
+    ASSERT_EQ(set.get(7), 12);
+}
+
+TEST(SparseSetWithType, ShrinkToFit) {
+    entt::SparseSet<unsigned int, int> set;
+    set.reserve(42);
+
+    set.construct(3, 3);
+    set.construct(12, 6);
+    set.construct(42, 9);
+    set.policy(entt::DeletionPolicy::TOMBSTONE);
+    set.destroy(3);
+    set.shrink_to_fit();
+
+    ASSERT_EQ(set.size(), 2u);
+    ASSERT_EQ(*(set.raw() + 0u), 6);
+    ASSERT_EQ(*(set.raw() + 1u), 9);
+    ASSERT_EQ(set.get(12), 6);
+    ASSERT_EQ(set.get(42), 9);
+}
+
+TEST(SparseSetWithType, Stats) {
+    entt::SparseSet<unsigned int, int> set;
+    auto stats = set.stats();
+
+    ASSERT_EQ(stats.size, 0u);
+    ASSERT_EQ(stats.extent, 0u);
+    ASSERT_EQ(stats.bytes(), 0u);
+    ASSERT_EQ(stats.fragmentation(), 0.);
+
+    set.reserve(4);
+    set.construct(3, 3);
+    set.construct(12, 6);
+    set.policy(entt::DeletionPolicy::TOMBSTONE);
+    set.destroy(12);
+    stats = set.stats();
+
+    ASSERT_EQ(stats.size, 1u);
+    ASSERT_EQ(stats.tombstones, 1u);
+    ASSERT_EQ(stats.capacity, 4u);
+    ASSERT_EQ(stats.extent, 13u);
+    ASSERT_GE(stats.sparse, 13u * sizeof(unsigned int));
+    ASSERT_EQ(stats.packed, 4u * sizeof(unsigned int));
+    ASSERT_EQ(stats.instances, 4u * sizeof(int));
+    ASSERT_EQ(stats.bytes(), stats.sparse + stats.packed + stats.instances);
+    ASSERT_EQ(stats.fragmentation(), 1. - 1. / 13.);
+
+    set.shrink_to_fit();
+    stats = set.stats();
+
+    ASSERT_EQ(stats.size, 1u);
+    ASSERT_EQ(stats.tombstones, 0u);
+    ASSERT_EQ(stats.extent, 4u);
+    ASSERT_EQ(stats.instances, sizeof(int));
+}
+
 TEST(SparseSetWithType, SortOrdered) {
     entt::SparseSet<unsigned int, int> set;
 
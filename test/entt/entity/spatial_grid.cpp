@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/spatial_grid.hpp>
+
+TEST(SpatialGrid, Functionalities) {
+    entt::SpatialGrid<std::uint32_t> grid{10.f};
+
+    ASSERT_TRUE(grid.empty());
+    ASSERT_EQ(grid.size(), decltype(grid)::size_type{0});
+    ASSERT_FALSE(grid.has(0));
+
+    grid.construct(0, 1.f, 1.f);
+    grid.construct(3, -5.f, 2.f);
+    grid.construct(7, 25.f, 25.f);
+
+    ASSERT_FALSE(grid.empty());
+    ASSERT_EQ(grid.size(), decltype(grid)::size_type{3});
+    ASSERT_TRUE(grid.has(0));
+    ASSERT_TRUE(grid.has(3));
+    ASSERT_FALSE(grid.has(5));
+
+    grid.destroy(0);
+
+    ASSERT_FALSE(grid.has(0));
+    ASSERT_TRUE(grid.has(3));
+    ASSERT_EQ(grid.size(), decltype(grid)::size_type{2});
+
+    grid.reset();
+
+    ASSERT_TRUE(grid.empty());
+    ASSERT_FALSE(grid.has(3));
+}
+
+TEST(SpatialGrid, Query) {
+    entt::SpatialGrid<std::uint32_t> grid{4.f};
+    std::vector<std::uint32_t> entities;
+
+    grid.construct(0, 0.f, 0.f);
+    grid.construct(1, 3.f, 4.f);
+    grid.construct(2, -3.f, -4.f);
+    grid.construct(3, 6.f, 0.f);
+    grid.construct(4, 100.f, 100.f);
+
+    grid.query(0.f, 0.f, 5.f, std::back_inserter(entities));
+    std::sort(entities.begin(), entities.end());
+
+    ASSERT_EQ(entities, (std::vector<std::uint32_t>{0, 1, 2}));
+
+    entities.clear();
+    grid.query(0.f, 0.f, 6.f, 4.f, std::back_inserter(entities));
+    std::sort(entities.begin(), entities.end());
+
+    ASSERT_EQ(entities, (std::vector<std::uint32_t>{0, 1, 3}));
+
+    entities.clear();
+    grid.query(-1000.f, -1000.f, 1000.f, 1000.f, std::back_inserter(entities));
+
+    ASSERT_EQ(entities.size(), decltype(entities)::size_type{5});
+
+    entities.clear();
+    grid.query(50.f, 50.f, 1.f, std::back_inserter(entities));
+
+    ASSERT_TRUE(entities.empty());
+}
+
+TEST(SpatialGrid, Update) {
+    entt::SpatialGrid<std::uint32_t, int> grid{8};
+    std::vector<std::uint32_t> entities;
+
+    grid.construct(0, 1, 1);
+    grid.construct(1, 2, 2);
+    grid.construct(2, 3, 3);
+
+    // same cell, different cell, back to the first cell
+    grid.update(0, 2, 1);
+    grid.update(1, 20, 20);
+    grid.update(2, 4, 4);
+
+    grid.query(0, 0, 7, 7, std::back_inserter(entities));
+    std::sort(entities.begin(), entities.end());
+
+    ASSERT_EQ(entities, (std::vector<std::uint32_t>{0, 2}));
+
+    entities.clear();
+    grid.query(20, 20, 0, std::back_inserter(entities));
+
+    ASSERT_EQ(entities, (std::vector<std::uint32_t>{1}));
+
+    grid.destroy(0);
+    grid.destroy(2);
+    entities.clear();
+    grid.query(0, 0, 7, 7, std::back_inserter(entities));
+
+    ASSERT_TRUE(entities.empty());
+    ASSERT_EQ(grid.size(), decltype(grid)::size_type{1});
+}
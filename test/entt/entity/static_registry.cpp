@@ -0,0 +1,191 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/static_registry.hpp>
+
+using StaticRegistry = entt::StaticRegistry<std::uint32_t, int, char, double>;
+
+TEST(StaticRegistry, Functionalities) {
+    StaticRegistry registry;
+
+    ASSERT_EQ(registry.size(), StaticRegistry::size_type{0});
+    ASSERT_TRUE(registry.empty());
+
+    ASSERT_EQ(registry.capacity(), StaticRegistry::size_type{0});
+    ASSERT_EQ(registry.size<int>(), StaticRegistry::size_type{0});
+    ASSERT_EQ(registry.size<char>(), StaticRegistry::size_type{0});
+    ASSERT_TRUE(registry.empty<int>());
+    ASSERT_TRUE(registry.empty<char>());
+
+    auto e1 = registry.create();
+    auto e2 = registry.create<int, char>();
+
+    ASSERT_EQ(registry.capacity(), StaticRegistry::size_type{2});
+    ASSERT_EQ(registry.size<int>(), StaticRegistry::size_type{1});
+    ASSERT_EQ(registry.size<char>(), StaticRegistry::size_type{1});
+    ASSERT_FALSE(registry.empty<int>());
+    ASSERT_FALSE(registry.empty<char>());
+
+    ASSERT_NE(e1, e2);
+
+    ASSERT_FALSE(registry.has<int>(e1));
+    ASSERT_TRUE(registry.has<int>(e2));
+    ASSERT_FALSE((registry.has<int, char>(e1)));
+    ASSERT_TRUE((registry.has<int, char>(e2)));
+
+    ASSERT_EQ(registry.assign<int>(e1, 42), 42);
+    ASSERT_EQ(registry.assign<char>(e1, 'c'), 'c');
+    ASSERT_NO_THROW(registry.remove<int>(e2));
+    ASSERT_NO_THROW(registry.remove<char>(e2));
+
+    ASSERT_TRUE((registry.has<int, char>(e1)));
+    ASSERT_FALSE(registry.has<int>(e2));
+    ASSERT_FALSE(registry.has<char>(e2));
+
+    auto e3 = registry.create();
+
+    registry.accomodate<int>(e3, registry.get<int>(e1));
+    registry.accomodate<char>(e3, registry.get<char>(e1));
+
+    ASSERT_EQ(registry.get<int>(e3), 42);
+    ASSERT_EQ(registry.get<char>(e3), 'c');
+
+    ASSERT_EQ(registry.replace<int>(e1, 0), 0);
+    ASSERT_EQ(registry.accomodate<int>(e1, 1), 1);
+    ASSERT_EQ(registry.get<int>(e1), 1);
+
+    const auto version = registry.version(e3);
+
+    registry.destroy(e3);
+
+    ASSERT_FALSE(registry.valid(e3));
+    ASSERT_EQ(registry.current(e3), version + 1);
+    ASSERT_EQ(registry.size<int>(), StaticRegistry::size_type{1});
+    ASSERT_EQ(registry.size(), StaticRegistry::size_type{2});
+
+    const auto e4 = registry.create<double>(3.);
+
+    ASSERT_EQ(e4 & entt::entt_traits<std::uint32_t>::entity_mask, e3 & entt::entt_traits<std::uint32_t>::entity_mask);
+    ASSERT_EQ(registry.get<double>(e4), 3.);
+
+    registry.reset<int>(e1);
+    registry.reset<int>(e2);
+
+    ASSERT_FALSE(registry.has<int>(e1));
+
+    registry.reset<char>();
+
+    ASSERT_TRUE(registry.empty<char>());
+
+    registry.reset();
+
+    ASSERT_TRUE(registry.empty());
+    ASSERT_TRUE(registry.empty<double>());
+    ASSERT_FALSE(registry.valid(e1));
+    ASSERT_FALSE(registry.valid(e4));
+}
+
+TEST(StaticRegistry, SingleComponent) {
+    entt::StaticRegistry<std::uint32_t, int> registry;
+
+    const auto entity = registry.create<int>(42);
+
+    ASSERT_EQ(registry.get<int>(entity), 42);
+    ASSERT_EQ(registry.view<int>().size(), decltype(registry)::size_type{1});
+}
+
+TEST(StaticRegistry, Each) {
+    StaticRegistry registry;
+    std::vector<StaticRegistry::entity_type> entities;
+
+    registry.create();
+    const auto entity = registry.create<int>();
+    registry.create();
+    registry.destroy(entity);
+
+    registry.each([&entities](auto entity) {
+        entities.push_back(entity);
+    });
+
+    ASSERT_EQ(entities.size(), decltype(entities)::size_type{2});
+}
+
+TEST(StaticRegistry, Tombstone) {
+    StaticRegistry registry;
+    registry.policy<int>(entt::DeletionPolicy::TOMBSTONE);
+
+    ASSERT_EQ(registry.policy<int>(), entt::DeletionPolicy::TOMBSTONE);
+    ASSERT_EQ(registry.policy<char>(), entt::DeletionPolicy::SWAP_AND_POP);
+
+    for(auto i = 0; i < 4; ++i) {
+        registry.assign<int>(registry.create(), i);
+    }
+
+    registry.view<int>().each([&registry](auto entity, const auto &) {
+        registry.destroy(entity);
+    });
+
+    ASSERT_EQ(registry.size<int>(), StaticRegistry::size_type{0});
+    ASSERT_TRUE(registry.empty<int>());
+
+    const auto entity = registry.create();
+    registry.assign<int>(entity, 42);
+    registry.compact();
+    registry.reserve<int>(4);
+    registry.shrink_to_fit();
+
+    ASSERT_EQ(registry.size<int>(), StaticRegistry::size_type{1});
+    ASSERT_EQ(registry.view<int>().size(), StaticRegistry::size_type{1});
+
+    registry.reset<int>();
+    registry.compact<int>();
+
+    ASSERT_EQ(registry.view<int>().size(), StaticRegistry::size_type{0});
+}
+
+TEST(StaticRegistry, Views) {
+    StaticRegistry registry;
+
+    const auto e0 = registry.create<int, char>(0, 'a');
+    registry.create<int>(1);
+    const auto e2 = registry.create<int, char>(2, 'c');
+
+    auto view = registry.view<int, char>();
+    auto persistent = registry.persistent<int, char>();
+    auto size = 0u;
+
+    view.each([&size](auto, auto &, auto &) { ++size; });
+
+    ASSERT_EQ(size, 2u);
+    ASSERT_EQ(registry.view<int>().size(), StaticRegistry::size_type{3});
+    ASSERT_EQ(persistent.size(), StaticRegistry::size_type{2});
+
+    registry.remove<char>(e0);
+
+    ASSERT_EQ(persistent.size(), StaticRegistry::size_type{1});
+    ASSERT_EQ(*persistent.begin(), e2);
+
+    registry.destroy(e2);
+
+    ASSERT_EQ(persistent.size(), StaticRegistry::size_type{0});
+}
+
+TEST(StaticRegistry, Sort) {
+    StaticRegistry registry;
+
+    registry.create<int, char>(3, 'c');
+    registry.create<int, char>(1, 'a');
+    registry.create<int, char>(2, 'b');
+
+    registry.sort<int>([](auto lhs, auto rhs) { return lhs < rhs; });
+    registry.sort<char, int>();
+
+    auto ints = registry.view<int>();
+    auto chars = registry.view<char>();
+
+    ASSERT_EQ(ints.get(*ints.begin()), 1);
+    ASSERT_EQ(chars.get(*chars.begin()), 'a');
+
+    for(StaticRegistry::size_type pos = 0; pos < ints.size(); ++pos) {
+        ASSERT_EQ(ints.data()[pos], chars.data()[pos]);
+    }
+}
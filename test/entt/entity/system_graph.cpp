@@ -0,0 +1,117 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/system_graph.hpp>
+#include <entt/entity/registry.hpp>
+
+struct Position { int x; };
+struct Velocity { int dx; };
+
+TEST(SystemGraph, Functionalities) {
+    entt::SystemGraph<int> graph{2};
+
+    ASSERT_EQ(graph.size(), entt::SystemGraph<int>::size_type{});
+    ASSERT_EQ(graph.concurrency(), entt::SystemGraph<int>::size_type{2});
+    ASSERT_TRUE(graph.empty());
+
+    int delta = 0;
+    int counter = 0;
+
+    graph.attach<entt::Write<int>>([&delta, &counter](auto value) { delta = value; ++counter; });
+
+    ASSERT_EQ(graph.size(), entt::SystemGraph<int>::size_type{1});
+    ASSERT_FALSE(graph.empty());
+
+    graph.update(42);
+
+    ASSERT_EQ(delta, 42);
+    ASSERT_EQ(counter, 1);
+
+    graph.clear();
+    graph.update(0);
+
+    ASSERT_EQ(graph.size(), entt::SystemGraph<int>::size_type{});
+    ASSERT_TRUE(graph.empty());
+    ASSERT_EQ(delta, 42);
+    ASSERT_EQ(counter, 1);
+}
+
+TEST(SystemGraph, ConflictingSystems) {
+    for(auto concurrency: { 1u, 2u, 4u }) {
+        entt::SystemGraph<int> graph{concurrency};
+        std::atomic<int> sequence{0};
+        int first = -1, second = -1, third = -1, fourth = -1;
+
+        graph.attach<entt::Write<Position>>([&](auto) { first = sequence++; });
+        graph.attach<entt::Read<Position>, entt::Write<Velocity>>([&](auto) { second = sequence++; });
+        graph.attach<entt::Read<Velocity>>([&](auto) { third = sequence++; });
+        graph.attach<entt::Read<Position>>([&](auto) { fourth = sequence++; });
+
+        for(auto i = 0; i < 10; ++i) {
+            sequence = 0;
+            graph.update(i);
+
+            ASSERT_EQ(sequence, 4);
+            ASSERT_LT(first, second);
+            ASSERT_LT(second, third);
+            ASSERT_LT(first, fourth);
+        }
+    }
+}
+
+TEST(SystemGraph, QualifiedComponents) {
+    entt::SystemGraph<int> graph{2};
+    std::atomic<int> sequence{0};
+    int first = -1, last = -1, second = -1;
+
+    // const qualified components refer to the same pools of the others
+    graph.attach<entt::Read<const Position>>([&](auto) {
+        first = sequence++;
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        last = sequence++;
+    });
+
+    graph.attach<entt::Write<Position>>([&](auto) { second = sequence++; });
+
+    for(auto i = 0; i < 5; ++i) {
+        sequence = 0;
+        graph.update(i);
+
+        ASSERT_EQ(sequence, 3);
+        ASSERT_LT(first, last);
+        ASSERT_LT(last, second);
+    }
+}
+
+TEST(SystemGraph, Registry) {
+    entt::DefaultRegistry registry;
+    entt::SystemGraph<int> graph{4};
+
+    for(auto i = 0; i < 100; ++i) {
+        registry.create(Position{0}, Velocity{i});
+    }
+
+    // pools must exist before running the systems concurrently
+    registry.view<Position, Velocity>();
+
+    graph.attach<entt::Read<Velocity>, entt::Write<Position>>([&registry](auto delta) {
+        registry.view<Position, Velocity>().each([delta](auto, auto &position, const auto &velocity) {
+            position.x += velocity.dx * delta;
+        });
+    });
+
+    graph.attach<entt::Write<Velocity>>([&registry](auto) {
+        registry.view<Velocity>().each([](auto, auto &velocity) {
+            velocity.dx = -velocity.dx;
+        });
+    });
+
+    graph.update(2);
+    graph.update(1);
+
+    registry.view<Position, Velocity>().each([](auto, const auto &position, const auto &velocity) {
+        ASSERT_EQ(position.x, velocity.dx);
+    });
+}
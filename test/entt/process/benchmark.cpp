@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+#include <entt/process/process.hpp>
+#include <entt/process/scheduler.hpp>
+#include "benchmark/harness.hpp"
+
+struct Counter: entt::Process<Counter, int> {
+    Counter(std::size_t *count): count{count} {}
+    void update(int) { ++*count; }
+    std::size_t *count;
+};
+
+template<typename Func>
+void eachProcessCount(Func func) {
+    for(std::size_t size: { 10000u, 100000u, 1000000u }) {
+        func(size, std::to_string(size) + " processes");
+    }
+}
+
+TEST(Benchmark, SchedulerAttach) {
+    eachProcessCount([](auto size, const auto &name) {
+        entt::Scheduler<int> scheduler;
+
+        measure("Attaching " + name + ", lambdas", size, [&scheduler]() {
+            scheduler.clear();
+        }, [&scheduler, size]() {
+            for(std::size_t i = 0; i < size; ++i) {
+                scheduler.attach([](auto, auto, auto) {});
+            }
+        });
+
+        ASSERT_EQ(scheduler.size(), size);
+    });
+}
+
+TEST(Benchmark, SchedulerUpdate) {
+    eachProcessCount([](auto size, const auto &name) {
+        entt::Scheduler<int> scheduler;
+        std::size_t count = 0;
+
+        for(std::size_t i = 0; i < size; ++i) {
+            scheduler.attach([&count](auto, auto, auto) { ++count; });
+        }
+
+        measure("Updating " + name + ", lambdas", size, [&scheduler]() {
+            scheduler.update(1);
+        });
+
+        for(std::size_t i = 0; i < size; ++i) {
+            scheduler.attach<Counter>(&count);
+        }
+
+        measure("Updating " + name + " and as many derived processes", 2 * size, [&scheduler]() {
+            scheduler.update(1);
+        });
+
+        ASSERT_NE(count, 0u);
+    });
+}
+
+TEST(Benchmark, SchedulerSucceed) {
+    eachProcessCount([](auto size, const auto &name) {
+        entt::Scheduler<int> scheduler;
+
+        measure("Running to completion " + name + ", lambdas", size, [&scheduler, size]() {
+            for(std::size_t i = 0; i < size; ++i) {
+                scheduler.attach([](auto, auto succeed, auto) { succeed(); });
+            }
+        }, [&scheduler]() {
+            scheduler.update(1);
+        });
+
+        ASSERT_TRUE(scheduler.empty());
+    });
+}
+
+TEST(Benchmark, SchedulerThen) {
+    eachProcessCount([](auto size, const auto &name) {
+        entt::Scheduler<int> scheduler;
+        const auto step = [](auto, auto succeed, auto) { succeed(); };
+
+        measure("Running to completion " + name + ", chains of four lambdas", 4 * size, [&]() {
+            for(std::size_t i = 0; i < size; ++i) {
+                scheduler.attach(step).then(step).then(step).then(step);
+            }
+        }, [&scheduler]() {
+            // continuations run within the same tick
+            scheduler.update(1);
+        });
+
+        ASSERT_TRUE(scheduler.empty());
+    });
+}
+
+TEST(Benchmark, SchedulerAbort) {
+    eachProcessCount([](auto size, const auto &name) {
+        entt::Scheduler<int> scheduler;
+
+        measure("Aborting " + name + ", lambdas", size, [&scheduler, size]() {
+            for(std::size_t i = 0; i < size; ++i) {
+                scheduler.attach([](auto, auto, auto) {});
+            }
+
+            scheduler.update(1);
+        }, [&scheduler]() {
+            scheduler.abort(true);
+            scheduler.update(1);
+        });
+
+        ASSERT_TRUE(scheduler.empty());
+    });
+}
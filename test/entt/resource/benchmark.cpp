@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <entt/core/hashed_string.hpp>
+#include <entt/resource/cache.hpp>
+#include "benchmark/harness.hpp"
+
+struct Texture {
+    int width;
+    int height;
+};
+
+struct TextureLoader: entt::ResourceLoader<TextureLoader, Texture> {
+    std::shared_ptr<Texture> load(int size) const {
+        return std::make_shared<Texture>(Texture{ size, size });
+    }
+};
+
+struct Identifiers {
+    Identifiers(std::size_t size)
+        : names{}, ids{}
+    {
+        for(std::size_t i = 0; i < size; ++i) {
+            names.push_back("textures/" + std::to_string(i) + ".png");
+        }
+
+        for(auto &&name: names) {
+            ids.emplace_back(name.c_str());
+        }
+    }
+
+    // a few resources are requested much more often than the others (zipf-like)
+    std::vector<std::size_t> draw(std::size_t count) const {
+        std::vector<double> weights;
+        std::vector<std::size_t> result;
+        std::mt19937 engine{42};
+
+        for(std::size_t i = 0; i < ids.size(); ++i) {
+            weights.push_back(1. / double(i + 1));
+        }
+
+        std::discrete_distribution<std::size_t> distribution{weights.cbegin(), weights.cend()};
+
+        for(std::size_t i = 0; i < count; ++i) {
+            result.push_back(distribution(engine));
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> names;
+    std::vector<entt::HashedString> ids;
+};
+
+TEST(Benchmark, ResourceCacheLoad) {
+    const Identifiers resources{10000u};
+    entt::ResourceCache<Texture> cache;
+
+    measure("Loading 10000 resources", 10000u, [&cache]() {
+        cache.clear();
+    }, [&]() {
+        for(auto &&id: resources.ids) {
+            cache.load<TextureLoader>(id, 64);
+        }
+    });
+
+    ASSERT_EQ(cache.size(), 10000u);
+
+    measure("Loading 10000 resources already in the cache", 10000u, [&]() {
+        for(auto &&id: resources.ids) {
+            cache.load<TextureLoader>(id, 64);
+        }
+    });
+}
+
+TEST(Benchmark, ResourceCacheHandle) {
+    const Identifiers resources{10000u};
+    const Identifiers missing{20000u};
+    const auto draws = resources.draw(1000000u);
+    entt::ResourceCache<Texture> cache;
+    int total = 0;
+
+    for(auto &&id: resources.ids) {
+        cache.load<TextureLoader>(id, 64);
+    }
+
+    measure("Getting 1000000 handles out of 10000 resources, zipf ids, hits", 1000000u, [&total]() {
+        total = 0;
+    }, [&]() {
+        for(auto pos: draws) {
+            total += cache.handle(resources.ids[pos])->width;
+        }
+    });
+
+    ASSERT_EQ(total, 64 * 1000000);
+
+    measure("Getting 1000000 handles out of 10000 resources, zipf ids, misses", 1000000u, [&total]() {
+        total = 0;
+    }, [&]() {
+        for(auto pos: draws) {
+            // the second half of the identifiers isn't in the cache
+            total += static_cast<bool>(cache.handle(missing.ids[10000u + pos]));
+        }
+    });
+
+    ASSERT_EQ(total, 0);
+}
+
+TEST(Benchmark, ResourceCacheChurn) {
+    const Identifiers resources{10000u};
+    const auto draws = resources.draw(100000u);
+    entt::ResourceCache<Texture> cache;
+
+    const auto setup = [&]() {
+        cache.clear();
+
+        for(auto &&id: resources.ids) {
+            cache.load<TextureLoader>(id, 64);
+        }
+    };
+
+    measure("Reloading 100000 resources out of 10000, zipf ids", 100000u, setup, [&]() {
+        for(auto pos: draws) {
+            cache.reload<TextureLoader>(resources.ids[pos], 128);
+        }
+    });
+
+    measure("Discarding and loading on demand 100000 resources out of 10000, zipf ids", 100000u, setup, [&]() {
+        for(std::size_t i = 0, last = draws.size(); i < last; ++i) {
+            const auto &id = resources.ids[draws[i]];
+
+            if(!cache.handle(id)) {
+                cache.load<TextureLoader>(id, 64);
+            }
+
+            // evicts a resource every other request, popular resources are reloaded often
+            if(i % 2) {
+                cache.discard(resources.ids[draws[last - i]]);
+            }
+        }
+    });
+
+    ASSERT_FALSE(cache.empty());
+}
@@ -56,6 +56,12 @@ TEST(ResourceCache, Functionalities) {
     ASSERT_TRUE(cache.contains(hs2));
     ASSERT_EQ(cache.handle(hs2)->value, 42);
 
+    ASSERT_TRUE(cache.reload<Loader>(hs2, 3));
+    ASSERT_EQ(cache.handle(hs2)->value, 3);
+    ASSERT_FALSE(cache.reload<BrokenLoader>(hs2, 3));
+    ASSERT_FALSE(cache.contains(hs2));
+    ASSERT_TRUE(cache.reload<Loader>(hs2, 42));
+
     ASSERT_TRUE(cache.load<Loader>(hs1, 42));
     ASSERT_NO_THROW(cache.clear());
 
@@ -0,0 +1,389 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <entt/signal/bus.hpp>
+#include <entt/signal/dispatcher.hpp>
+#include <entt/signal/emitter.hpp>
+#include <entt/signal/sigh.hpp>
+#include <entt/signal/signal.hpp>
+#include "benchmark/allocations.hpp"
+#include "benchmark/harness.hpp"
+
+struct SmallEvent {
+    int value;
+};
+
+struct LargeEvent {
+    int value;
+    char padding[252];
+};
+
+struct Listener {
+    void receive(const SmallEvent &event) { count += event.value; }
+    void receive(const LargeEvent &event) { count += event.value; }
+
+    void receive(const SmallEvent *events, std::size_t size) {
+        for(std::size_t pos = 0; pos < size; ++pos) {
+            count += events[pos].value;
+        }
+    }
+
+    std::size_t count{};
+};
+
+struct MyEmitter: entt::Emitter<MyEmitter> {};
+
+static const std::size_t calls = 1000000u;
+
+template<typename Func>
+void eachListenerCount(Func func) {
+    for(std::size_t listeners: { 1u, 10u, 100u, 1000u }) {
+        func(listeners, " to " + std::to_string(listeners) + " listener(s)");
+    }
+}
+
+template<typename Event>
+void sighPublish(const std::string &event) {
+    eachListenerCount([&event](auto size, const auto &suffix) {
+        std::vector<Listener> listeners(size);
+        entt::SigH<void(const Event &)> sigh;
+
+        for(auto &&listener: listeners) {
+            sigh.template connect<Listener, &Listener::receive>(&listener);
+        }
+
+        measure("Publishing " + std::to_string(calls / size) + " " + event + " events" + suffix + ", SigH", calls, [&sigh, size]() {
+            for(std::size_t i = 0, last = calls / size; i < last; ++i) {
+                sigh.publish({ 1 });
+            }
+        });
+
+        ASSERT_EQ(listeners[0].count % (calls / size), 0u);
+    });
+}
+
+template<typename Event>
+void signalPublish(const std::string &event) {
+    eachListenerCount([&event](auto size, const auto &suffix) {
+        std::vector<std::shared_ptr<Listener>> listeners;
+        entt::Signal<void(const Event &)> signal;
+
+        for(std::size_t i = 0; i < size; ++i) {
+            listeners.push_back(std::make_shared<Listener>());
+            signal.template connect<Listener, &Listener::receive>(listeners.back());
+        }
+
+        measure("Publishing " + std::to_string(calls / size) + " " + event + " events" + suffix + ", Signal", calls, [&signal, size]() {
+            for(std::size_t i = 0, last = calls / size; i < last; ++i) {
+                signal.publish({ 1 });
+            }
+        });
+
+        measure("Publishing " + std::to_string(calls / size) + " " + event + " events" + suffix + ", Signal batch", calls, [&signal, size]() {
+            const auto batch = signal.batch();
+
+            for(std::size_t i = 0, last = calls / size; i < last; ++i) {
+                batch.publish({ 1 });
+            }
+        });
+
+        ASSERT_EQ(signal.size(), size);
+    });
+}
+
+TEST(Benchmark, SigHPublish) {
+    sighPublish<SmallEvent>("small");
+    sighPublish<LargeEvent>("large");
+}
+
+TEST(Benchmark, SigHFewListeners) {
+    for(std::size_t size: { 0u, 1u, 2u, 4u }) {
+        const auto suffix = std::to_string(size) + " listener(s) each, SigH";
+        std::vector<Listener> listeners(size);
+        const auto base = Allocations::rebase();
+
+        {
+            std::vector<entt::SigH<void(const SmallEvent &)>> signals(100000u);
+
+            for(auto &&sigh: signals) {
+                for(auto &&listener: listeners) {
+                    sigh.connect<Listener, &Listener::receive>(&listener);
+                }
+            }
+
+            footprint("Memory of 100000 signals with " + suffix, signals.size(), Allocations::peak() - base, Allocations::current() - base);
+
+            measure("Publishing 10 events to 100000 signals with " + suffix, 10u * signals.size(), [&signals]() {
+                for(auto i = 0; i < 10; ++i) {
+                    for(auto &&sigh: signals) {
+                        sigh.publish({ 0 });
+                    }
+                }
+            });
+        }
+    }
+}
+
+TEST(Benchmark, SigHConnectDisconnect) {
+    for(std::size_t size: { 100u, 1000u, 5000u }) {
+        std::vector<Listener> listeners(size);
+        entt::SigH<void(const SmallEvent &)> sigh;
+
+        measure("Connecting and disconnecting " + std::to_string(size) + " listeners, SigH", size, [&]() {
+            for(auto &&listener: listeners) {
+                sigh.connect<Listener, &Listener::receive>(&listener);
+            }
+
+            for(auto &&listener: listeners) {
+                sigh.disconnect<Listener, &Listener::receive>(&listener);
+            }
+        });
+
+        ASSERT_TRUE(sigh.empty());
+
+        std::vector<entt::SigH<void(const SmallEvent &)>::Connection> connections;
+
+        measure("Connecting and disconnecting " + std::to_string(size) + " listeners with connections, SigH", size, [&connections]() {
+            connections.clear();
+        }, [&]() {
+            for(auto &&listener: listeners) {
+                connections.push_back(sigh.connect<Listener, &Listener::receive>(&listener));
+            }
+
+            for(auto &&conn: connections) {
+                sigh.disconnect(conn);
+            }
+        });
+
+        ASSERT_TRUE(sigh.empty());
+    }
+}
+
+TEST(Benchmark, SignalPublish) {
+    signalPublish<SmallEvent>("small");
+    signalPublish<LargeEvent>("large");
+}
+
+TEST(Benchmark, SignalConnectDisconnect) {
+    for(std::size_t size: { 100u, 1000u, 5000u }) {
+        std::vector<std::shared_ptr<Listener>> listeners;
+        entt::Signal<void(const SmallEvent &)> signal;
+
+        for(std::size_t i = 0; i < size; ++i) {
+            listeners.push_back(std::make_shared<Listener>());
+        }
+
+        measure("Connecting and disconnecting " + std::to_string(size) + " listeners, Signal", size, [&]() {
+            for(auto &&listener: listeners) {
+                signal.connect<Listener, &Listener::receive>(listener);
+            }
+
+            for(auto &&listener: listeners) {
+                signal.disconnect<Listener, &Listener::receive>(listener);
+            }
+        });
+
+        ASSERT_TRUE(signal.empty());
+
+        std::vector<entt::Signal<void(const SmallEvent &)>::Connection> connections;
+
+        measure("Connecting and disconnecting " + std::to_string(size) + " listeners with connections, Signal", size, [&connections]() {
+            connections.clear();
+        }, [&]() {
+            for(auto &&listener: listeners) {
+                connections.push_back(signal.connect<Listener, &Listener::receive>(listener));
+            }
+
+            for(auto &&conn: connections) {
+                signal.disconnect(conn);
+            }
+        });
+
+        ASSERT_TRUE(signal.empty());
+    }
+}
+
+TEST(Benchmark, DispatcherEnqueueUpdate) {
+    for(std::size_t size: { 1u, 10u }) {
+        std::vector<Listener> listeners(size);
+        entt::UnmanagedDispatcher dispatcher;
+        const auto suffix = " to " + std::to_string(size) + " listener(s), unmanaged dispatcher";
+
+        for(auto &&listener: listeners) {
+            dispatcher.connect<SmallEvent>(&listener);
+        }
+
+        measure("Enqueueing " + std::to_string(calls) + " events" + suffix, calls, [&dispatcher]() {
+            dispatcher.update();
+        }, [&dispatcher]() {
+            for(std::size_t i = 0; i < calls; ++i) {
+                dispatcher.enqueue<SmallEvent>(1);
+            }
+        });
+
+        measure("Delivering " + std::to_string(calls) + " queued events" + suffix, calls, [&dispatcher]() {
+            for(std::size_t i = 0; i < calls; ++i) {
+                dispatcher.enqueue<SmallEvent>(1);
+            }
+        }, [&dispatcher]() {
+            dispatcher.update();
+        });
+
+        measure("Triggering " + std::to_string(calls) + " events" + suffix, calls, [&dispatcher]() {
+            for(std::size_t i = 0; i < calls; ++i) {
+                dispatcher.trigger<SmallEvent>(1);
+            }
+        });
+    }
+}
+
+TEST(Benchmark, DispatcherBatches) {
+    for(std::size_t size: { 1u, 10u }) {
+        std::vector<Listener> listeners(size);
+        entt::UnmanagedDispatcher dispatcher;
+        const auto suffix = " in batches to " + std::to_string(size) + " listener(s), unmanaged dispatcher";
+
+        for(auto &&listener: listeners) {
+            dispatcher.connect_batch<SmallEvent>(&listener);
+        }
+
+        measure("Delivering " + std::to_string(calls) + " queued events" + suffix, calls, [&dispatcher]() {
+            for(std::size_t i = 0; i < calls; ++i) {
+                dispatcher.enqueue<SmallEvent>(1);
+            }
+        }, [&dispatcher]() {
+            dispatcher.update();
+        });
+
+        ASSERT_NE(listeners[0].count, 0u);
+    }
+}
+
+TEST(Benchmark, ManagedDispatcherEnqueueUpdate) {
+    for(std::size_t size: { 1u, 10u }) {
+        std::vector<std::shared_ptr<Listener>> listeners;
+        entt::ManagedDispatcher dispatcher;
+        const auto suffix = " to " + std::to_string(size) + " listener(s), managed dispatcher";
+
+        for(std::size_t i = 0; i < size; ++i) {
+            listeners.push_back(std::make_shared<Listener>());
+            dispatcher.connect<SmallEvent>(listeners.back());
+        }
+
+        measure("Delivering " + std::to_string(calls) + " queued events" + suffix, calls, [&dispatcher]() {
+            for(std::size_t i = 0; i < calls; ++i) {
+                dispatcher.enqueue<SmallEvent>(1);
+            }
+        }, [&dispatcher]() {
+            dispatcher.update();
+        });
+    }
+}
+
+template<typename Dispatcher, typename Func>
+void concurrentEnqueue(const std::string &name, Func enqueue) {
+    for(std::size_t size: { 1u, 2u, 4u }) {
+        Listener listener;
+        Dispatcher dispatcher;
+
+        dispatcher.template connect<SmallEvent>(&listener);
+
+        measure("Enqueueing " + std::to_string(calls) + " events from " + std::to_string(size) + " thread(s), " + name, calls, [&dispatcher]() {
+            dispatcher.update();
+        }, [&dispatcher, &enqueue, size]() {
+            std::vector<std::thread> producers;
+
+            for(std::size_t i = 0; i < size; ++i) {
+                producers.emplace_back([&dispatcher, &enqueue, size]() {
+                    for(std::size_t j = 0, last = calls / size; j < last; ++j) {
+                        enqueue(dispatcher);
+                    }
+                });
+            }
+
+            for(auto &&producer: producers) {
+                producer.join();
+            }
+        });
+
+        dispatcher.update();
+
+        ASSERT_NE(listener.count, 0u);
+    }
+}
+
+TEST(Benchmark, DispatcherMultipleProducers) {
+    std::mutex mutex;
+
+    concurrentEnqueue<entt::UnmanagedDispatcher>("unmanaged dispatcher and a mutex", [&mutex](auto &dispatcher) {
+        std::lock_guard<std::mutex> lock{mutex};
+        dispatcher.template enqueue<SmallEvent>(1);
+    });
+
+    concurrentEnqueue<entt::UnmanagedConcurrentDispatcher>("unmanaged concurrent dispatcher", [](auto &dispatcher) {
+        dispatcher.template enqueue<SmallEvent>(1);
+    });
+}
+
+TEST(Benchmark, EmitterPublish) {
+    eachListenerCount([](auto size, const auto &suffix) {
+        MyEmitter emitter;
+        std::size_t count = 0;
+
+        for(std::size_t i = 0; i < size; ++i) {
+            emitter.on<SmallEvent>([&count](const auto &event, auto &) { count += event.value; });
+        }
+
+        measure("Publishing " + std::to_string(calls / size) + " small events" + suffix + ", Emitter", calls, [&emitter, size]() {
+            for(std::size_t i = 0, last = calls / size; i < last; ++i) {
+                emitter.publish<SmallEvent>(1);
+            }
+        });
+
+        ASSERT_EQ(count % (calls / size), 0u);
+    });
+}
+
+TEST(Benchmark, EmitterOnErase) {
+    for(std::size_t size: { 100u, 1000u, 5000u }) {
+        MyEmitter emitter;
+        std::vector<MyEmitter::Connection<SmallEvent>> connections;
+
+        measure("Connecting and disconnecting " + std::to_string(size) + " listeners, Emitter", size, [&connections]() {
+            connections.clear();
+        }, [&]() {
+            for(std::size_t i = 0; i < size; ++i) {
+                connections.push_back(emitter.on<SmallEvent>([](const auto &, auto &) {}));
+            }
+
+            for(auto &&conn: connections) {
+                emitter.erase(conn);
+            }
+        });
+
+        ASSERT_TRUE(emitter.empty());
+    }
+}
+
+TEST(Benchmark, BusPublish) {
+    eachListenerCount([](auto size, const auto &suffix) {
+        std::vector<Listener> listeners(size);
+        entt::UnmanagedBus<SmallEvent, LargeEvent> bus;
+
+        for(auto &&listener: listeners) {
+            bus.reg(&listener);
+        }
+
+        measure("Publishing " + std::to_string(calls / size) + " small events" + suffix + ", Bus", calls, [&bus, size]() {
+            for(std::size_t i = 0, last = calls / size; i < last; ++i) {
+                bus.publish<SmallEvent>(1);
+            }
+        });
+
+        ASSERT_EQ(bus.size(), 2u * size);
+    });
+}
@@ -1,4 +1,7 @@
+#include <cstddef>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <entt/signal/dispatcher.hpp>
 
@@ -37,6 +40,51 @@ void testDispatcher(Rec receiver) {
     ASSERT_EQ(receiver->cnt, static_cast<decltype(receiver->cnt)>(0));
 }
 
+struct BatchReceiver {
+    void receive(const Event *, std::size_t size) { ++calls; cnt += size; }
+    void receive(const Event &) { ++single; }
+    std::size_t calls{0};
+    std::size_t cnt{0};
+    std::size_t single{0};
+};
+
+template<typename Dispatcher, typename Rec>
+void testBatches(Rec receiver) {
+    Dispatcher dispatcher;
+
+    dispatcher.template connect_batch<Event>(receiver);
+    dispatcher.template trigger<Event>();
+
+    ASSERT_EQ(receiver->calls, static_cast<decltype(receiver->calls)>(1));
+    ASSERT_EQ(receiver->cnt, static_cast<decltype(receiver->cnt)>(1));
+
+    dispatcher.template enqueue<Event>();
+    dispatcher.template enqueue<Event>();
+    dispatcher.template enqueue<Event>();
+    dispatcher.update();
+    dispatcher.update();
+
+    ASSERT_EQ(receiver->calls, static_cast<decltype(receiver->calls)>(2));
+    ASSERT_EQ(receiver->cnt, static_cast<decltype(receiver->cnt)>(4));
+
+    dispatcher.template connect<Event>(receiver);
+    dispatcher.template enqueue<Event>();
+    dispatcher.template enqueue<Event>();
+    dispatcher.update();
+
+    ASSERT_EQ(receiver->calls, static_cast<decltype(receiver->calls)>(3));
+    ASSERT_EQ(receiver->cnt, static_cast<decltype(receiver->cnt)>(6));
+    ASSERT_EQ(receiver->single, static_cast<decltype(receiver->single)>(2));
+
+    dispatcher.template disconnect_batch<Event>(receiver);
+    dispatcher.template enqueue<Event>();
+    dispatcher.update();
+    dispatcher.template trigger<Event>();
+
+    ASSERT_EQ(receiver->calls, static_cast<decltype(receiver->calls)>(3));
+    ASSERT_EQ(receiver->single, static_cast<decltype(receiver->single)>(4));
+}
+
 TEST(ManagedDispatcher, Basics) {
     testDispatcher<entt::ManagedDispatcher>(std::make_shared<Receiver>());
 }
@@ -45,3 +93,74 @@ TEST(UnmanagedDispatcher, Basics) {
     auto ptr = std::make_unique<Receiver>();
     testDispatcher<entt::UnmanagedDispatcher>(ptr.get());
 }
+
+TEST(ManagedDispatcher, Batches) {
+    testBatches<entt::ManagedDispatcher>(std::make_shared<BatchReceiver>());
+}
+
+TEST(UnmanagedDispatcher, Batches) {
+    auto ptr = std::make_unique<BatchReceiver>();
+    testBatches<entt::UnmanagedDispatcher>(ptr.get());
+}
+
+TEST(ManagedConcurrentDispatcher, Basics) {
+    testDispatcher<entt::ManagedConcurrentDispatcher>(std::make_shared<Receiver>());
+}
+
+TEST(UnmanagedConcurrentDispatcher, Basics) {
+    auto ptr = std::make_unique<Receiver>();
+    testDispatcher<entt::UnmanagedConcurrentDispatcher>(ptr.get());
+}
+
+TEST(Dispatcher, EnqueueDuringUpdate) {
+    struct Forwarder {
+        void receive(const Event &) { dispatcher->enqueue<int>(); }
+        void receive(const int &) { ++cnt; }
+        entt::UnmanagedDispatcher *dispatcher;
+        std::size_t cnt{0};
+    };
+
+    entt::UnmanagedDispatcher dispatcher;
+    Forwarder forwarder{&dispatcher};
+
+    // events of the second type are queued after the first type is delivered
+    dispatcher.connect<int>(&forwarder);
+    dispatcher.connect<Event>(&forwarder);
+    dispatcher.enqueue<Event>();
+    dispatcher.update();
+
+    ASSERT_EQ(forwarder.cnt, static_cast<decltype(forwarder.cnt)>(0));
+
+    dispatcher.update();
+
+    ASSERT_EQ(forwarder.cnt, static_cast<decltype(forwarder.cnt)>(1));
+}
+
+TEST(UnmanagedConcurrentDispatcher, MultipleProducers) {
+    entt::UnmanagedConcurrentDispatcher dispatcher;
+    std::vector<std::thread> producers;
+    Receiver receiver;
+
+    dispatcher.connect<Event>(&receiver);
+
+    for(auto i = 0; i < 4; ++i) {
+        producers.emplace_back([&dispatcher]() {
+            for(auto j = 0; j < 10000; ++j) {
+                dispatcher.enqueue<Event>();
+            }
+        });
+    }
+
+    // the consumer delivers events while producers are running
+    for(auto i = 0; i < 100; ++i) {
+        dispatcher.update();
+    }
+
+    for(auto &&producer: producers) {
+        producer.join();
+    }
+
+    dispatcher.update();
+
+    ASSERT_EQ(receiver.cnt, static_cast<decltype(receiver.cnt)>(40000));
+}
@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/signal/queue.hpp>
+
+struct Message {
+    std::size_t producer;
+    std::size_t value;
+};
+
+TEST(EventQueue, Functionalities) {
+    entt::EventQueue<Message> queue;
+    std::vector<Message> events;
+
+    queue.push(0u, 0u);
+    queue.push(0u, 1u);
+    queue.flip(events);
+
+    ASSERT_EQ(events.size(), 2u);
+    ASSERT_EQ(events[0].value, 0u);
+    ASSERT_EQ(events[1].value, 1u);
+
+    queue.push(0u, 2u);
+    queue.flip(events);
+    queue.flip(events);
+
+    ASSERT_EQ(events.size(), 3u);
+    ASSERT_EQ(events[2].value, 2u);
+}
+
+TEST(ConcurrentEventQueue, Functionalities) {
+    entt::ConcurrentEventQueue<Message> queue;
+    std::vector<Message> events;
+
+    queue.push(0u, 0u);
+    queue.push(0u, 1u);
+    queue.flip(events);
+
+    ASSERT_EQ(events.size(), 2u);
+    ASSERT_EQ(events[0].value, 0u);
+    ASSERT_EQ(events[1].value, 1u);
+
+    queue.push(0u, 2u);
+    queue.flip(events);
+    queue.flip(events);
+
+    ASSERT_EQ(events.size(), 3u);
+    ASSERT_EQ(events[2].value, 2u);
+
+    // pending events are discarded along with the queue
+    queue.push(0u, 3u);
+}
+
+TEST(ConcurrentEventQueue, MultipleProducers) {
+    entt::ConcurrentEventQueue<Message> queue;
+    std::vector<std::thread> producers;
+    std::vector<Message> events;
+
+    for(std::size_t producer = 0; producer < 4u; ++producer) {
+        producers.emplace_back([&queue, producer]() {
+            for(std::size_t value = 0; value < 10000u; ++value) {
+                queue.push(producer, value);
+            }
+        });
+    }
+
+    // the consumer drains the queue while producers are running
+    for(auto i = 0; i < 100; ++i) {
+        queue.flip(events);
+    }
+
+    for(auto &&producer: producers) {
+        producer.join();
+    }
+
+    queue.flip(events);
+
+    std::vector<std::size_t> next(4u, 0u);
+
+    ASSERT_EQ(events.size(), 40000u);
+
+    for(auto &&event: events) {
+        ASSERT_EQ(event.value, next[event.producer]++);
+    }
+}
@@ -145,6 +145,118 @@ TEST(SigH, Members) {
     ASSERT_EQ((entt::SigH<bool(int)>::size_type)0, sigh.size());
 }
 
+TEST(SigH, ManyListeners) {
+    struct S {
+        void f(int &v) { v += value; }
+        int value;
+    };
+
+    std::vector<S> listeners{ { 1 }, { 2 }, { 4 }, { 8 }, { 16 } };
+    entt::SigH<void(int &)> sigh;
+    int v = 0;
+
+    // more listeners than those stored inline
+    for(auto &&listener: listeners) {
+        sigh.connect<S, &S::f>(&listener);
+    }
+
+    sigh.publish(v);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)5, sigh.size());
+    ASSERT_EQ(31, v);
+
+    auto copy = sigh;
+    auto other = std::move(sigh);
+
+    ASSERT_TRUE(copy == other);
+    ASSERT_TRUE(sigh.empty());
+
+    sigh = copy;
+    copy.disconnect<S, &S::f>(&listeners[2]);
+    copy.disconnect<S, &S::f>(&listeners[0]);
+    copy.disconnect<S, &S::f>(&listeners[3]);
+
+    v = 0;
+    copy.publish(v);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)2, copy.size());
+    ASSERT_EQ(18, v);
+
+    swap(copy, other);
+
+    v = 0;
+    copy.publish(v);
+    other.publish(v);
+    sigh.publish(v);
+
+    ASSERT_EQ(80, v);
+
+    other = std::move(copy);
+    copy.connect<S, &S::f>(&listeners[0]);
+    copy.clear();
+
+    ASSERT_TRUE(copy.empty());
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)5, other.size());
+}
+
+TEST(SigH, Connections) {
+    struct S {
+        void f(int &v) { v += value; }
+        int value;
+    };
+
+    std::vector<S> listeners{ { 1 }, { 2 }, { 4 }, { 8 } };
+    std::vector<entt::SigH<void(int &)>::Connection> connections;
+    entt::SigH<void(int &)> sigh;
+    int v = 0;
+
+    for(auto &&listener: listeners) {
+        connections.push_back(sigh.connect<S, &S::f>(&listener));
+    }
+
+    sigh.disconnect(connections[1]);
+    sigh.disconnect(connections[1]);
+    sigh.disconnect(entt::SigH<void(int &)>::Connection{});
+    sigh.publish(v);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)3, sigh.size());
+    ASSERT_EQ(13, v);
+
+    // free slots are reused, stale connections don't affect new listeners
+    connections[1] = sigh.connect<S, &S::f>(&listeners[1]);
+    sigh.disconnect(connections[3]);
+    sigh.disconnect(connections[3]);
+
+    v = 0;
+    sigh.publish(v);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)3, sigh.size());
+    ASSERT_EQ(7, v);
+
+    connections[3] = sigh.connect<S, &S::f>(&listeners[0]);
+    sigh.disconnect(connections[3]);
+
+    v = 0;
+    sigh.publish(v);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)2, sigh.size());
+    ASSERT_EQ(6, v);
+
+    sigh.disconnect(connections[1]);
+    sigh.disconnect(connections[2]);
+
+    ASSERT_TRUE(sigh.empty());
+    ASSERT_TRUE(sigh == entt::SigH<void(int &)>{});
+
+    // connections don't survive a clear, not even when slots are reused
+    connections[0] = sigh.connect<S, &S::f>(&listeners[0]);
+    sigh.clear();
+    sigh.connect<S, &S::f>(&listeners[1]);
+    sigh.disconnect(connections[0]);
+
+    ASSERT_EQ((entt::SigH<void(int &)>::size_type)1, sigh.size());
+}
+
 template<typename Ret>
 struct TestCollectAll {
     std::vector<Ret> vec{};
@@ -162,3 +162,129 @@ TEST(Signal, Cleanup) {
     ASSERT_TRUE(signal.empty());
     ASSERT_EQ(S::i, val);
 }
+
+TEST(Signal, Connections) {
+    entt::Signal<void(const int &)> signal;
+    auto first = std::make_shared<S>();
+    auto second = std::make_shared<S>();
+
+    auto conn = signal.connect<S, &S::g>(first);
+    signal.connect<S, &S::h>(first);
+    signal.connect<&S::f>();
+
+    // listeners connected twice are registered once and share the connection
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{3}, signal.size());
+    signal.disconnect(signal.connect<S, &S::h>(first));
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{2}, signal.size());
+    signal.connect<S, &S::h>(first);
+
+    signal.disconnect(conn);
+    signal.disconnect(conn);
+    signal.disconnect(entt::Signal<void(const int &)>::Connection{});
+    S::i = 0;
+    signal.publish(42);
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{2}, signal.size());
+    ASSERT_EQ(S::i, 42);
+
+    // the free slot is reused, the old connection doesn't refer to it
+    conn = signal.connect<S, &S::g>(second);
+    signal.disconnect(signal.connect<&S::f>());
+    first = nullptr;
+    S::i = 0;
+    signal.publish(3);
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{1}, signal.size());
+    ASSERT_EQ(S::i, 3);
+
+    signal.disconnect(conn);
+
+    ASSERT_TRUE(signal.empty());
+    ASSERT_TRUE(signal == entt::Signal<void(const int &)>{});
+
+    // connections don't survive a clear, not even when slots are reused
+    conn = signal.connect<&S::f>();
+    signal.clear();
+    signal.connect<S, &S::g>(second);
+    signal.disconnect(conn);
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{1}, signal.size());
+}
+
+TEST(Signal, Aliasing) {
+    struct Pair {
+        struct Counter {
+            void f(const int &v) { count += v; }
+            int count{};
+        } first, second;
+    };
+
+    entt::Signal<void(const int &)> signal;
+    auto pair = std::make_shared<Pair>();
+    std::shared_ptr<Pair::Counter> first{pair, &pair->first};
+    std::shared_ptr<Pair::Counter> second{pair, &pair->second};
+
+    // aliasing pointers share the owner but refer to different listeners
+    signal.connect<Pair::Counter, &Pair::Counter::f>(first);
+    signal.connect<Pair::Counter, &Pair::Counter::f>(second);
+    signal.disconnect<Pair::Counter, &Pair::Counter::f>(first);
+    signal.publish(3);
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{1}, signal.size());
+    ASSERT_EQ(pair->first.count, 0);
+    ASSERT_EQ(pair->second.count, 3);
+
+    signal.disconnect(first);
+
+    ASSERT_FALSE(signal.empty());
+
+    signal.disconnect(second);
+
+    ASSERT_TRUE(signal.empty());
+}
+
+TEST(Signal, Batch) {
+    struct Counter {
+        void f(const int &v) { count += v; }
+        int count{};
+    };
+
+    entt::Signal<void(const int &)> signal;
+    auto first = std::make_shared<Counter>();
+    auto second = std::make_shared<Counter>();
+    auto expired = std::make_shared<Counter>();
+
+    signal.connect<Counter, &Counter::f>(first);
+    signal.connect<Counter, &Counter::f>(second);
+    signal.connect<Counter, &Counter::f>(expired);
+    signal.connect<&S::f>();
+    expired = nullptr;
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{4}, signal.size());
+
+    {
+        const auto batch = signal.batch();
+        std::weak_ptr<Counter> pinned = second;
+
+        // expired listeners are disconnected when the batch is created
+        ASSERT_EQ(entt::Signal<void(const int &)>::size_type{3}, signal.size());
+
+        second = nullptr;
+
+        ASSERT_FALSE(pinned.expired());
+
+        S::i = 0;
+        batch.publish(1);
+        batch.publish(2);
+
+        ASSERT_EQ(first->count, 3);
+        ASSERT_EQ(pinned.lock()->count, 3);
+        ASSERT_EQ(S::i, 2);
+    }
+
+    signal.publish(4);
+
+    ASSERT_EQ(entt::Signal<void(const int &)>::size_type{2}, signal.size());
+    ASSERT_EQ(first->count, 7);
+    ASSERT_EQ(S::i, 4);
+}